@@ -0,0 +1,133 @@
+/********************************************************************
+KWin - the KDE window manager
+This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#include "kwin_wayland_test.h"
+#include "placement.h"
+#include "platform.h"
+#include "shell_client.h"
+#include "wayland_server.h"
+#include "workspace.h"
+
+#include <KWayland/Client/surface.h>
+#include <KWayland/Client/shell.h>
+
+using namespace KWin;
+using namespace KWayland::Client;
+
+static const QString s_socketName = QStringLiteral("wayland_test_kwin_placement-0");
+
+class PlacementTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void initTestCase();
+    void init();
+    void cleanup();
+
+    void testPlaceSmart();
+    void testPlaceSmartIgnoresKeepBelow();
+};
+
+void PlacementTest::initTestCase()
+{
+    qRegisterMetaType<KWin::ShellClient*>();
+    qRegisterMetaType<KWin::AbstractClient*>();
+    QSignalSpy workspaceCreatedSpy(kwinApp(), &Application::workspaceCreated);
+    QVERIFY(workspaceCreatedSpy.isValid());
+    kwinApp()->platform()->setInitialWindowSize(QSize(1280, 1024));
+    QVERIFY(waylandServer()->init(s_socketName.toLocal8Bit()));
+
+    kwinApp()->start();
+    QVERIFY(workspaceCreatedSpy.wait());
+    waylandServer()->initWorkspace();
+}
+
+void PlacementTest::init()
+{
+    QVERIFY(Test::setupWaylandConnection());
+}
+
+void PlacementTest::cleanup()
+{
+    Test::destroyWaylandConnection();
+}
+
+void PlacementTest::testPlaceSmart()
+{
+    // this test verifies that smart placement puts windows next to each other
+    // and only starts a new row once there is no more room in the current one
+    const QRect area(0, 0, 1280, 1024);
+
+    QScopedPointer<Surface> surface1(Test::createSurface());
+    QScopedPointer<ShellSurface> shellSurface1(Test::createShellSurface(surface1.data()));
+    auto client1 = Test::renderAndWaitForShown(surface1.data(), QSize(600, 500), Qt::blue);
+    QVERIFY(client1);
+    Placement::self()->placeSmart(client1, area);
+    QCOMPARE(client1->geometry(), QRect(0, 0, 600, 500));
+
+    QScopedPointer<Surface> surface2(Test::createSurface());
+    QScopedPointer<ShellSurface> shellSurface2(Test::createShellSurface(surface2.data()));
+    auto client2 = Test::renderAndWaitForShown(surface2.data(), QSize(600, 500), Qt::blue);
+    QVERIFY(client2);
+    Placement::self()->placeSmart(client2, area);
+    QCOMPARE(client2->geometry(), QRect(600, 0, 600, 500));
+
+    QScopedPointer<Surface> surface3(Test::createSurface());
+    QScopedPointer<ShellSurface> shellSurface3(Test::createShellSurface(surface3.data()));
+    auto client3 = Test::renderAndWaitForShown(surface3.data(), QSize(600, 500), Qt::blue);
+    QVERIFY(client3);
+    Placement::self()->placeSmart(client3, area);
+    QCOMPARE(client3->geometry(), QRect(0, 500, 600, 500));
+
+    shellSurface1.reset();
+    QVERIFY(Test::waitForWindowDestroyed(client1));
+    shellSurface2.reset();
+    QVERIFY(Test::waitForWindowDestroyed(client2));
+    shellSurface3.reset();
+    QVERIFY(Test::waitForWindowDestroyed(client3));
+}
+
+void PlacementTest::testPlaceSmartIgnoresKeepBelow()
+{
+    // windows kept below do not count as overlapping
+    const QRect area(0, 0, 1280, 1024);
+
+    QScopedPointer<Surface> surface1(Test::createSurface());
+    QScopedPointer<ShellSurface> shellSurface1(Test::createShellSurface(surface1.data()));
+    auto client1 = Test::renderAndWaitForShown(surface1.data(), QSize(600, 500), Qt::blue);
+    QVERIFY(client1);
+    Placement::self()->placeSmart(client1, area);
+    QCOMPARE(client1->geometry(), QRect(0, 0, 600, 500));
+    client1->setKeepBelow(true);
+
+    QScopedPointer<Surface> surface2(Test::createSurface());
+    QScopedPointer<ShellSurface> shellSurface2(Test::createShellSurface(surface2.data()));
+    auto client2 = Test::renderAndWaitForShown(surface2.data(), QSize(600, 500), Qt::blue);
+    QVERIFY(client2);
+    Placement::self()->placeSmart(client2, area);
+    QCOMPARE(client2->geometry(), QRect(0, 0, 600, 500));
+
+    shellSurface1.reset();
+    QVERIFY(Test::waitForWindowDestroyed(client1));
+    shellSurface2.reset();
+    QVERIFY(Test::waitForWindowDestroyed(client2));
+}
+
+WAYLANDTEST_MAIN(PlacementTest)
+#include "placement_test.moc"
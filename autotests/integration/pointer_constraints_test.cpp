@@ -66,6 +66,7 @@ private Q_SLOTS:
     void testBreakConstrainedPointer();
     void testCloseWindowWithLockedPointer_data();
     void testCloseWindowWithLockedPointer();
+    void testConfinedPointerWithPendingMotion();
 };
 
 void TestPointerConstraints::initTestCase()
@@ -84,6 +85,9 @@ void TestPointerConstraints::initTestCase()
     KConfigGroup group = config->group("OnScreenNotification");
     group.writeEntry(QStringLiteral("QmlPath"), QString("/does/not/exist.qml"));
     group.sync();
+    group = config->group("Wayland");
+    group.writeEntry("BatchPointerMotion", true);
+    group.sync();
 
     kwinApp()->setConfig(config);
 
@@ -435,5 +439,34 @@ void TestPointerConstraints::testCloseWindowWithLockedPointer()
     QCOMPARE(input()->pointer()->isConstrained(), false);
 }
 
+void TestPointerConstraints::testConfinedPointerWithPendingMotion()
+{
+    // this test verifies that relative motion batched before a confinement gets activated
+    // is not lost once the motion is passed on unbatched
+    QScopedPointer<Surface> surface(Test::createSurface());
+    QScopedPointer<QObject> shellSurface(Test::createShellSurface(Test::ShellSurfaceType::XdgShellV6, surface.data()));
+    QScopedPointer<Pointer> pointer(Test::waylandSeat()->createPointer());
+    auto c = Test::renderAndWaitForShown(surface.data(), QSize(100, 100), Qt::blue);
+    QVERIFY(c);
+    const QPoint center = c->geometry().center();
+    KWin::Cursor::setPos(center);
+    QCOMPARE(input()->pointer()->isConstrained(), false);
+
+    // the relative motion gets batched until the next frame
+    quint32 timestamp = 1;
+    input()->pointer()->processRelativeMotion(QSizeF(10, 0), QSizeF(10, 0), timestamp++, 0, nullptr);
+    QCOMPARE(KWin::Cursor::pos(), center);
+
+    // confine without going through the event loop, which would flush the batch
+    QScopedPointer<ConfinedPointer> confinedPointer(Test::waylandPointerConstraints()->confinePointer(surface.data(), pointer.data(), nullptr, PointerConstraints::LifeTime::OneShot));
+    Test::flushWaylandConnection();
+    waylandServer()->dispatch();
+    QCOMPARE(input()->pointer()->isConstrained(), true);
+
+    // the batched motion is processed before the new one
+    input()->pointer()->processRelativeMotion(QSizeF(5, 0), QSizeF(5, 0), timestamp++, 0, nullptr);
+    QCOMPARE(KWin::Cursor::pos(), center + QPoint(15, 0));
+}
+
 WAYLANDTEST_MAIN(TestPointerConstraints)
 #include "pointer_constraints_test.moc"
@@ -254,8 +254,8 @@ void PointerInputTest::testWarpingDuringFilter()
     QCOMPARE(window->pos(), QPoint(0, 0));
     QVERIFY(window->geometry().contains(Cursor::pos()));
 
-    // is PresentWindows effect for top left screen edge loaded
-    QVERIFY(static_cast<EffectsHandlerImpl*>(effects)->isEffectLoaded("presentwindows"));
+    // is PresentWindows effect for top left screen edge loaded, it is loaded after the other effects
+    QTRY_VERIFY(static_cast<EffectsHandlerImpl*>(effects)->isEffectLoaded("presentwindows"));
     QVERIFY(movedSpy.isEmpty());
     quint32 timestamp = 0;
     kwinApp()->platform()->pointerMotion(QPoint(0, 0), timestamp++);
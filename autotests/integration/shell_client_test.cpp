@@ -79,6 +79,8 @@ private Q_SLOTS:
     void testUnresponsiveWindow();
     void testX11WindowId_data();
     void testX11WindowId();
+    void testFindClient_data();
+    void testFindClient();
 };
 
 void TestShellClient::initTestCase()
@@ -859,5 +861,55 @@ void TestShellClient::testX11WindowId()
     QCOMPARE(c->window(), 0u);
 }
 
+void TestShellClient::testFindClient_data()
+{
+    QTest::addColumn<Test::ShellSurfaceType>("type");
+
+    QTest::newRow("wlShell") << Test::ShellSurfaceType::WlShell;
+    QTest::newRow("xdgShellV5") << Test::ShellSurfaceType::XdgShellV5;
+    QTest::newRow("xdgShellV6") << Test::ShellSurfaceType::XdgShellV6;
+}
+
+void TestShellClient::testFindClient()
+{
+    // this test verifies that clients can be found by surface, window id and connection
+    // and are no longer found once they got destroyed
+    QFETCH(Test::ShellSurfaceType, type);
+    QScopedPointer<Surface> surface1(Test::createSurface());
+    QScopedPointer<QObject> shellSurface1(Test::createShellSurface(type, surface1.data()));
+    auto c1 = Test::renderAndWaitForShown(surface1.data(), QSize(100, 50), Qt::blue);
+    QVERIFY(c1);
+    QScopedPointer<Surface> surface2(Test::createSurface());
+    QScopedPointer<QObject> shellSurface2(Test::createShellSurface(type, surface2.data()));
+    auto c2 = Test::renderAndWaitForShown(surface2.data(), QSize(100, 50), Qt::red);
+    QVERIFY(c2);
+    QVERIFY(c1 != c2);
+
+    QCOMPARE(waylandServer()->findClient(c1->surface()), c1);
+    QCOMPARE(waylandServer()->findClient(c2->surface()), c2);
+    QCOMPARE(waylandServer()->findAbstractClient(c2->surface()), c2);
+    QCOMPARE(waylandServer()->findClient(c1->windowId()), c1);
+    QCOMPARE(waylandServer()->findClient(c2->windowId()), c2);
+    QVERIFY(!waylandServer()->findClient(quint32(0)));
+    QVERIFY(!waylandServer()->findClient(static_cast<KWayland::Server::SurfaceInterface*>(nullptr)));
+
+    auto connection = c1->surface()->client();
+    QCOMPARE(c2->surface()->client(), connection);
+    auto clients = waylandServer()->findClients(connection);
+    QCOMPARE(clients.count(), 2);
+    QVERIFY(clients.contains(c1));
+    QVERIFY(clients.contains(c2));
+
+    const quint32 windowId = c1->windowId();
+    auto serverSurface = c1->surface();
+    shellSurface1.reset();
+    surface1.reset();
+    QVERIFY(Test::waitForWindowDestroyed(c1));
+    QVERIFY(!waylandServer()->findClient(windowId));
+    QVERIFY(!waylandServer()->findClient(serverSurface));
+    QCOMPARE(waylandServer()->findClients(connection), QList<ShellClient*>{c2});
+    QCOMPARE(waylandServer()->findClient(c2->windowId()), c2);
+}
+
 WAYLANDTEST_MAIN(TestShellClient)
 #include "shell_client_test.moc"
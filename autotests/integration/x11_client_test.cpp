@@ -53,6 +53,7 @@ private Q_SLOTS:
     void testCaptionChanges();
     void testCaptionWmName();
     void testCaptionMultipleWindows();
+    void testPropertyFetchedOncePerNotify();
 };
 
 void X11ClientTest::initTestCase()
@@ -523,5 +524,92 @@ void X11ClientTest::testCaptionMultipleWindows()
     QTRY_COMPARE(QByteArray(info5.visibleIconName()), QByteArray());
 }
 
+/**
+ * Returns how many requests KWin sent to the X server while running @p function.
+ **/
+template <typename Function>
+static uint32_t countRequests(Function function)
+{
+    xcb_connection_t *c = kwinApp()->x11Connection();
+    const auto before = xcb_get_input_focus_unchecked(c).sequence;
+    xcb_discard_reply(c, before);
+    function();
+    const auto after = xcb_get_input_focus_unchecked(c).sequence;
+    xcb_discard_reply(c, after);
+    return after - before - 1;
+}
+
+void X11ClientTest::testPropertyFetchedOncePerNotify()
+{
+    // this test verifies that a changed property is fetched from the X server only once,
+    // even if an effect and the window itself both read it for the same PropertyNotify
+    QScopedPointer<xcb_connection_t, XcbConnectionDeleter> c(xcb_connect(nullptr, nullptr));
+    QVERIFY(!xcb_connection_has_error(c.data()));
+    const QRect windowGeometry(0, 0, 100, 200);
+    xcb_window_t w = xcb_generate_id(c.data());
+    xcb_create_window(c.data(), XCB_COPY_FROM_PARENT, w, rootWindow(),
+                      windowGeometry.x(),
+                      windowGeometry.y(),
+                      windowGeometry.width(),
+                      windowGeometry.height(),
+                      0, XCB_WINDOW_CLASS_INPUT_OUTPUT, XCB_COPY_FROM_PARENT, 0, nullptr);
+    xcb_size_hints_t hints;
+    memset(&hints, 0, sizeof(hints));
+    xcb_icccm_size_hints_set_position(&hints, 1, windowGeometry.x(), windowGeometry.y());
+    xcb_icccm_size_hints_set_size(&hints, 1, windowGeometry.width(), windowGeometry.height());
+    xcb_icccm_set_wm_normal_hints(c.data(), w, &hints);
+    xcb_map_window(c.data(), w);
+    xcb_flush(c.data());
+
+    QSignalSpy windowCreatedSpy(workspace(), &Workspace::clientAdded);
+    QVERIFY(windowCreatedSpy.isValid());
+    QVERIFY(windowCreatedSpy.wait());
+    Client *client = windowCreatedSpy.first().first().value<Client*>();
+    QVERIFY(client);
+    QCOMPARE(client->windowId(), w);
+
+    // announce the property like an effect does, so that the effects get notified about it
+    auto effectsImpl = static_cast<EffectsHandlerImpl*>(effects);
+    const QByteArray propertyName = QByteArrayLiteral("_KWIN_TEST_PROPERTY_CACHE");
+    const xcb_atom_t atom = effectsImpl->announceSupportProperty(propertyName, nullptr);
+    QVERIFY(atom != XCB_ATOM_NONE);
+
+    uint32_t requests = 0;
+    QByteArray value;
+    connect(effects, &EffectsHandler::propertyNotify, this,
+        [&] (EffectWindow *window, long a) {
+            if (window != client->effectWindow() || xcb_atom_t(a) != atom) {
+                return;
+            }
+            requests += countRequests([&] { value = window->readProperty(atom, atom, 32); });
+        }
+    );
+    QSignalSpy propertyNotifySpy(effects, &EffectsHandler::propertyNotify);
+    QVERIFY(propertyNotifySpy.isValid());
+
+    for (uint32_t data = 1; data <= 2; ++data) {
+        requests = 0;
+        xcb_change_property(c.data(), XCB_PROP_MODE_REPLACE, w, atom, atom, 32, 1, &data);
+        xcb_flush(c.data());
+        QVERIFY(propertyNotifySpy.wait());
+        QCOMPARE(requests, 1u);
+        QCOMPARE(value, QByteArray(reinterpret_cast<const char*>(&data), sizeof(data)));
+        // the value read by the effect is still cached once the notify has been handled
+        requests += countRequests([&] { value = client->readProperty(atom, atom, 32); });
+        QCOMPARE(requests, 1u);
+        QCOMPARE(value, QByteArray(reinterpret_cast<const char*>(&data), sizeof(data)));
+    }
+    effectsImpl->removeSupportProperty(propertyName, nullptr);
+
+    // and destroy the window again
+    QSignalSpy windowClosedSpy(client, &Client::windowClosed);
+    QVERIFY(windowClosedSpy.isValid());
+    xcb_unmap_window(c.data(), w);
+    xcb_flush(c.data());
+    QVERIFY(windowClosedSpy.wait());
+    xcb_destroy_window(c.data(), w);
+    c.reset();
+}
+
 WAYLANDTEST_MAIN(X11ClientTest)
 #include "x11_client_test.moc"
@@ -90,5 +90,40 @@ void TestTabBoxClientModel::testCreateClientListActiveClientNotInFocusChain()
     QCOMPARE(clientModel->rowCount(), 1);
 }
 
+void TestTabBoxClientModel::testCreateClientListIncremental()
+{
+    MockTabBoxHandler tabboxhandler;
+    tabboxhandler.setConfig(TabBox::TabBoxConfig());
+    TabBox::ClientModel *clientModel = new TabBox::ClientModel(&tabboxhandler);
+    QSignalSpy resetSpy(clientModel, &QAbstractItemModel::modelReset);
+    QVERIFY(resetSpy.isValid());
+    QSignalSpy insertedSpy(clientModel, &QAbstractItemModel::rowsInserted);
+    QVERIFY(insertedSpy.isValid());
+    QSignalSpy removedSpy(clientModel, &QAbstractItemModel::rowsRemoved);
+    QVERIFY(removedSpy.isValid());
+
+    QWeakPointer<TabBox::TabBoxClient> client = tabboxhandler.createMockWindow(QString("test"), 1);
+    tabboxhandler.createMockWindow(QString("longer test"), 2);
+    clientModel->createClientList();
+    QCOMPARE(clientModel->rowCount(), 2);
+    QCOMPARE(insertedSpy.count(), 2);
+    QCOMPARE(clientModel->longestCaption(), QString("longer test"));
+
+    // recreating the same list should neither insert nor remove rows
+    clientModel->createClientList();
+    QCOMPARE(clientModel->rowCount(), 2);
+    QCOMPARE(insertedSpy.count(), 2);
+    QCOMPARE(removedSpy.count(), 0);
+
+    // removing a window only removes its row
+    QSharedPointer<TabBox::TabBoxClient> clientOwner = client.toStrongRef();
+    tabboxhandler.closeWindow(client.data());
+    clientModel->createClientList();
+    QCOMPARE(clientModel->rowCount(), 1);
+    QCOMPARE(removedSpy.count(), 1);
+    QCOMPARE(insertedSpy.count(), 2);
+    QCOMPARE(resetSpy.count(), 0);
+}
+
 Q_CONSTRUCTOR_FUNCTION(forceXcb)
 QTEST_MAIN(TestTabBoxClientModel)
@@ -48,6 +48,11 @@ private slots:
      * See BUG: 306260
      **/
     void testCreateClientListActiveClientNotInFocusChain();
+    /**
+     * Tests that recreating the Client list updates the model
+     * through row changes instead of resetting it.
+     **/
+    void testCreateClientListIncremental();
 };
 
 #endif
@@ -66,6 +66,7 @@ private Q_SLOTS:
     void testLoadBuiltInEffect_data();
     void testLoadBuiltInEffect();
     void testLoadAllEffects();
+    void testLoadOnDemandEffectsLast();
 };
 
 void TestBuiltInEffectLoader::initTestCase()
@@ -570,6 +571,45 @@ void TestBuiltInEffectLoader::testLoadAllEffects()
     QCOMPARE(loadedEffects.at(1), QStringLiteral("mouseclick"));
 }
 
+void TestBuiltInEffectLoader::testLoadOnDemandEffectsLast()
+{
+    MockEffectsHandler mockHandler(KWin::XRenderCompositing);
+    KWin::BuiltInEffectLoader loader;
+
+    KSharedConfig::Ptr config = KSharedConfig::openConfig(QString(), KConfig::SimpleConfig);
+
+    // only load mouseclick, which is activated on demand, and mousemark and zoom which come after
+    // it, zoom does not opt in to be loaded on demand as it restores the zoom level when loaded
+    KConfigGroup plugins = config->group("Plugins");
+    const auto builtInEffects = KWin::BuiltInEffects::availableEffectNames();
+    for (const QString &name : builtInEffects) {
+        plugins.writeEntry(name + QStringLiteral("Enabled"), false);
+    }
+    plugins.writeEntry(QStringLiteral("mouseclickEnabled"), true);
+    plugins.writeEntry(QStringLiteral("mousemarkEnabled"), true);
+    plugins.writeEntry(QStringLiteral("zoomEnabled"), true);
+    plugins.sync();
+
+    loader.setConfig(config);
+
+    qRegisterMetaType<KWin::Effect*>();
+    QSignalSpy spy(&loader, SIGNAL(effectLoaded(KWin::Effect*,QString)));
+    connect(&loader, &KWin::BuiltInEffectLoader::effectLoaded,
+        [](KWin::Effect *effect) {
+            effect->deleteLater();
+        }
+    );
+
+    loader.queryAndLoadAll();
+    QTest::qWait(100);
+    QCOMPARE(spy.size(), 3);
+    QCOMPARE(spy.at(0).at(1).toString(), QStringLiteral("mousemark"));
+    QCOMPARE(spy.at(1).at(1).toString(), QStringLiteral("zoom"));
+    QCOMPARE(spy.at(2).at(1).toString(), QStringLiteral("mouseclick"));
+    QVERIFY(KWin::BuiltInEffects::effectData(KWin::BuiltInEffect::MouseClick).loadedOnDemand);
+    QVERIFY(!KWin::BuiltInEffects::effectData(KWin::BuiltInEffect::Zoom).loadedOnDemand);
+}
+
 Q_CONSTRUCTOR_FUNCTION(forceXcb)
 QTEST_MAIN(TestBuiltInEffectLoader)
 #include "test_builtin_effectloader.moc"
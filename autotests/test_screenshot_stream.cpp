@@ -0,0 +1,236 @@
+/********************************************************************
+KWin - the KDE window manager
+This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#include "../effects/screenshot/screenshotstream.h"
+
+#include <QtTest/QtTest>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+using namespace KWin;
+
+class ScreenShotStreamTest : public QObject
+{
+    Q_OBJECT
+private Q_SLOTS:
+    void testHeader();
+    void testDamageAcrossSlots();
+    void testDamageClippedToGeometry();
+    void testTooManyDamageRects();
+    void testWriteRect();
+};
+
+/**
+ * Maps the shared memory of a stream read-only, like a client does.
+ **/
+class StreamMapping
+{
+public:
+    explicit StreamMapping(const ScreenShotStream &stream) {
+        struct stat info;
+        if (fstat(stream.fd(), &info) != 0) {
+            return;
+        }
+        void *data = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, stream.fd(), 0);
+        if (data != MAP_FAILED) {
+            m_data = static_cast<const uchar*>(data);
+            m_size = info.st_size;
+        }
+    }
+    ~StreamMapping() {
+        if (m_data) {
+            munmap(const_cast<uchar*>(m_data), m_size);
+        }
+    }
+    bool isValid() const {
+        return m_data != nullptr;
+    }
+    const ScreenShotStream::Header *header() const {
+        return reinterpret_cast<const ScreenShotStream::Header*>(m_data);
+    }
+    const ScreenShotStream::FrameHeader *frame(int slot) const {
+        return reinterpret_cast<const ScreenShotStream::FrameHeader*>(m_data + header()->firstSlotOffset + header()->slotSize * slot);
+    }
+    QRgb pixel(int slot, int x, int y) const {
+        const uchar *pixels = reinterpret_cast<const uchar*>(frame(slot)) + frame(slot)->pixelOffset;
+        return reinterpret_cast<const QRgb*>(pixels + y * header()->stride)[x];
+    }
+    QRegion damage(int slot) const {
+        QRegion region;
+        const ScreenShotStream::FrameHeader *f = frame(slot);
+        for (quint32 i = 0; i < f->damageCount && i < ScreenShotStream::MaxDamageRects; ++i) {
+            region += QRect(f->damage[i].x, f->damage[i].y, f->damage[i].width, f->damage[i].height);
+        }
+        return region;
+    }
+
+private:
+    const uchar *m_data = nullptr;
+    size_t m_size = 0;
+};
+
+void ScreenShotStreamTest::testHeader()
+{
+    ScreenShotStream stream(QRect(10, 20, 8, 4));
+    QVERIFY(stream.isValid());
+    QVERIFY(stream.fd() != -1);
+    QCOMPARE(stream.geometry(), QRect(10, 20, 8, 4));
+
+    StreamMapping mapping(stream);
+    QVERIFY(mapping.isValid());
+    QCOMPARE(mapping.header()->magic, quint32(ScreenShotStream::Magic));
+    QCOMPARE(mapping.header()->version, quint32(ScreenShotStream::Version));
+    QCOMPARE(mapping.header()->width, 8u);
+    QCOMPARE(mapping.header()->height, 4u);
+    QCOMPARE(mapping.header()->stride, 32u);
+    QCOMPARE(mapping.header()->slotCount, quint32(ScreenShotStream::SlotCount));
+    QCOMPARE(mapping.header()->sequence, 0ull);
+    for (int i = 0; i < ScreenShotStream::SlotCount; ++i) {
+        QCOMPARE(mapping.frame(i)->sequence, 0ull);
+        QCOMPARE(mapping.frame(i)->damageCount, 0u);
+    }
+
+    // an empty area can not be streamed
+    QVERIFY(!ScreenShotStream(QRect()).isValid());
+}
+
+void ScreenShotStreamTest::testDamageAcrossSlots()
+{
+    const QRect geometry(100, 100, 10, 10);
+    ScreenShotStream stream(geometry);
+    QVERIFY(stream.isValid());
+    StreamMapping mapping(stream);
+    QVERIFY(mapping.isValid());
+
+    // none of the slots got written yet, each has to be filled completely once
+    QCOMPARE(stream.beginFrame(QRegion()), QRegion(geometry));
+    QCOMPARE(stream.commitFrame(), 1ull);
+    QCOMPARE(mapping.header()->latestSlot, 0u);
+    QCOMPARE(mapping.header()->sequence, 1ull);
+    QCOMPARE(mapping.frame(0)->sequence, 1ull);
+    QCOMPARE(mapping.frame(0)->damageCount, 0u);
+
+    QCOMPARE(stream.beginFrame(QRect(100, 100, 2, 2)), QRegion(geometry));
+    QCOMPARE(stream.commitFrame(), 2ull);
+    QCOMPARE(mapping.header()->latestSlot, 1u);
+    QCOMPARE(mapping.damage(1), QRegion(0, 0, 2, 2));
+
+    QCOMPARE(stream.beginFrame(QRect(105, 105, 1, 1)), QRegion(geometry));
+    // the slot being written is marked as incomplete till it gets committed
+    QCOMPARE(mapping.frame(2)->sequence, 0ull);
+    QCOMPARE(mapping.header()->sequence, 2ull);
+    QCOMPARE(stream.commitFrame(), 3ull);
+    QCOMPARE(mapping.header()->latestSlot, 2u);
+    QCOMPARE(mapping.frame(2)->sequence, 3ull);
+    QCOMPARE(mapping.damage(2), QRegion(5, 5, 1, 1));
+
+    // back at the first slot, which misses what changed in the two frames after it
+    QCOMPARE(stream.beginFrame(QRect(108, 100, 1, 1)),
+             QRegion(100, 100, 2, 2) + QRegion(105, 105, 1, 1) + QRegion(108, 100, 1, 1));
+    QCOMPARE(stream.commitFrame(), 4ull);
+    QCOMPARE(mapping.header()->latestSlot, 0u);
+    // the frame damage is relative to the frame before, not to the previous content of the slot
+    QCOMPARE(mapping.damage(0), QRegion(8, 0, 1, 1));
+
+    // the second slot misses the changes of the third and fourth frame
+    QCOMPARE(stream.beginFrame(QRegion()), QRegion(105, 105, 1, 1) + QRegion(108, 100, 1, 1));
+    QCOMPARE(stream.commitFrame(), 5ull);
+    QCOMPARE(mapping.header()->latestSlot, 1u);
+    QCOMPARE(mapping.frame(1)->damageCount, 0u);
+
+    // and the third slot only the ones of the fourth frame
+    QCOMPARE(stream.beginFrame(QRegion()), QRegion(108, 100, 1, 1));
+    QCOMPARE(stream.commitFrame(), 6ull);
+
+    // once all slots caught up nothing is left to write
+    QCOMPARE(stream.beginFrame(QRegion()), QRegion());
+    QCOMPARE(stream.commitFrame(), 7ull);
+}
+
+void ScreenShotStreamTest::testDamageClippedToGeometry()
+{
+    const QRect geometry(100, 100, 10, 10);
+    ScreenShotStream stream(geometry);
+    QVERIFY(stream.isValid());
+    StreamMapping mapping(stream);
+    QVERIFY(mapping.isValid());
+
+    QCOMPARE(stream.beginFrame(QRect(0, 0, 200, 101)), QRegion(geometry));
+    stream.commitFrame();
+    QCOMPARE(mapping.damage(0), QRegion(0, 0, 10, 1));
+
+    // damage outside of the area does not cause anything to be written
+    for (int i = 1; i < ScreenShotStream::SlotCount; ++i) {
+        stream.beginFrame(QRegion());
+        stream.commitFrame();
+    }
+    QCOMPARE(stream.beginFrame(QRect(0, 0, 50, 50)), QRegion());
+    stream.commitFrame();
+    QCOMPARE(mapping.frame(0)->damageCount, 0u);
+}
+
+void ScreenShotStreamTest::testTooManyDamageRects()
+{
+    ScreenShotStream stream(QRect(0, 0, 100, 100));
+    QVERIFY(stream.isValid());
+    StreamMapping mapping(stream);
+    QVERIFY(mapping.isValid());
+
+    QRegion damage;
+    for (int i = 0; i <= ScreenShotStream::MaxDamageRects; ++i) {
+        damage += QRect(i * 2, i * 2, 1, 1);
+    }
+    QCOMPARE(damage.rects().count(), int(ScreenShotStream::MaxDamageRects) + 1);
+    stream.beginFrame(damage);
+    stream.commitFrame();
+    // the reader has to consider the complete frame as changed
+    QCOMPARE(mapping.frame(0)->damageCount, quint32(ScreenShotStream::MaxDamageRects + 1));
+}
+
+void ScreenShotStreamTest::testWriteRect()
+{
+    const QRect geometry(100, 100, 4, 4);
+    ScreenShotStream stream(geometry);
+    QVERIFY(stream.isValid());
+    StreamMapping mapping(stream);
+    QVERIFY(mapping.isValid());
+
+    stream.beginFrame(QRegion());
+    QImage background(4, 4, QImage::Format_ARGB32);
+    background.fill(Qt::red);
+    stream.writeRect(geometry, background);
+    // only the part inside of the streamed area is written
+    QImage overlapping(4, 4, QImage::Format_RGB32);
+    overlapping.fill(Qt::blue);
+    stream.writeRect(QRect(102, 102, 4, 4), overlapping);
+    // an image not matching the rect is ignored
+    stream.writeRect(QRect(100, 100, 1, 1), overlapping);
+    stream.commitFrame();
+
+    for (int y = 0; y < 4; ++y) {
+        for (int x = 0; x < 4; ++x) {
+            const QRgb expected = (x >= 2 && y >= 2) ? QColor(Qt::blue).rgba() : QColor(Qt::red).rgba();
+            QCOMPARE(mapping.pixel(0, x, y), expected);
+        }
+    }
+}
+
+QTEST_GUILESS_MAIN(ScreenShotStreamTest)
+#include "test_screenshot_stream.moc"
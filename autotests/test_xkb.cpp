@@ -19,7 +19,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 *********************************************************************/
 #include "../xkb.h"
 
+#include <KConfigGroup>
+
 #include <QtTest/QtTest>
+#include <xkbcommon/xkbcommon.h>
 #include <xkbcommon/xkbcommon-keysyms.h>
 
 using namespace KWin;
@@ -28,10 +31,12 @@ class XkbTest : public QObject
 {
     Q_OBJECT
 private Q_SLOTS:
+    void initTestCase();
     void testToQtKey_data();
     void testToQtKey();
     void testFromQtKey_data();
     void testFromQtKey();
+    void testKeymapCache();
 };
 
 // from kwindowsystem/src/platforms/xcb/kkeyserver.cpp
@@ -473,6 +478,12 @@ static const TransKey g_rgQtToSymX[] = {
     { Qt::Key_9, XKB_KEY_KP_9, Qt::KeypadModifier }
 };
 
+void XkbTest::initTestCase()
+{
+    QStandardPaths::setTestModeEnabled(true);
+    QDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kwin/xkb")).removeRecursively();
+}
+
 void XkbTest::testToQtKey_data()
 {
     QTest::addColumn<Qt::Key>("qt");
@@ -509,5 +520,44 @@ void XkbTest::testFromQtKey()
     QTEST(xkb.fromQtKey(qt, modifiers), "keySym");
 }
 
+void XkbTest::testKeymapCache()
+{
+    KSharedConfigPtr config = KSharedConfig::openConfig(QString(), KConfig::SimpleConfig);
+    KConfigGroup layoutGroup = config->group("Layout");
+    layoutGroup.writeEntry("LayoutList", QStringLiteral("de,us"));
+    layoutGroup.sync();
+
+    const QDir cacheDir(QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kwin/xkb"));
+    QVERIFY(cacheDir.entryList(QDir::Files).isEmpty());
+
+    Xkb compiled;
+    compiled.setConfig(config);
+    compiled.reconfigure();
+    QVERIFY(compiled.keymap());
+    QCOMPARE(compiled.numberOfLayouts(), 2u);
+    // compiling the keymap stores it in the cache
+    QCOMPARE(cacheDir.entryList(QDir::Files).count(), 1);
+
+    // a second instance loads the same keymap from the cache
+    Xkb cached;
+    cached.setConfig(config);
+    cached.reconfigure();
+    QVERIFY(cached.keymap());
+    QCOMPARE(cacheDir.entryList(QDir::Files).count(), 1);
+    QCOMPARE(cached.layoutNames(), compiled.layoutNames());
+    char *compiledString = xkb_keymap_get_as_string(compiled.keymap(), XKB_KEYMAP_FORMAT_TEXT_V1);
+    char *cachedString = xkb_keymap_get_as_string(cached.keymap(), XKB_KEYMAP_FORMAT_TEXT_V1);
+    QCOMPARE(QByteArray(cachedString), QByteArray(compiledString));
+    free(compiledString);
+    free(cachedString);
+
+    // a different layout gets its own entry
+    layoutGroup.writeEntry("LayoutList", QStringLiteral("us"));
+    layoutGroup.sync();
+    cached.reconfigure();
+    QCOMPARE(cached.numberOfLayouts(), 1u);
+    QCOMPARE(cacheDir.entryList(QDir::Files).count(), 2);
+}
+
 QTEST_MAIN(XkbTest)
 #include "test_xkb.moc"
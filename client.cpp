@@ -51,7 +51,6 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 // XLib
 #include <X11/Xutil.h>
 #include <fixx11h.h>
-#include <xcb/xcb_icccm.h>
 // system
 #include <unistd.h>
 #include <signal.h>
@@ -1408,29 +1407,44 @@ void Client::fetchName()
     setCaption(readName());
 }
 
-static inline QString readNameProperty(xcb_window_t w, xcb_atom_t atom)
+static inline QString readNameProperty(Xcb::Property &prop)
 {
-    const auto cookie = xcb_icccm_get_text_property_unchecked(connection(), w, atom);
-    xcb_icccm_get_text_property_reply_t reply;
-    if (xcb_icccm_get_wm_name_reply(connection(), cookie, &reply, nullptr)) {
-        QString retVal;
-        if (reply.encoding == atoms->utf8_string) {
-            retVal = QString::fromUtf8(QByteArray(reply.name, reply.name_len));
-        } else if (reply.encoding == XCB_ATOM_STRING) {
-            retVal = QString::fromLocal8Bit(QByteArray(reply.name, reply.name_len));
-        }
-        xcb_icccm_get_text_property_reply_wipe(&reply);
-        return retVal.simplified();
+    if (prop.isNull()) {
+        return QString();
+    }
+    QString retVal;
+    if (prop->type == atoms->utf8_string) {
+        retVal = QString::fromUtf8(prop.toByteArray(8, atoms->utf8_string));
+    } else if (prop->type == XCB_ATOM_STRING) {
+        retVal = QString::fromLocal8Bit(prop.toByteArray(8, XCB_ATOM_STRING));
     }
-    return QString();
+    return retVal.simplified();
+}
+
+/**
+ * Requests the ICCCM text property @p atom (WM_NAME or WM_ICON_NAME) without
+ * waiting for the reply. It is only used as fallback if the EWMH name is not set.
+ */
+Xcb::Property Client::fetchNameProperty(xcb_atom_t atom) const
+{
+    return Xcb::Property(false, window(), atom, XCB_ATOM_ANY, 0, 10000);
 }
 
 QString Client::readName() const
+{
+    Xcb::Property nameProp;
+    if (!info->name() || info->name()[0] == '\0') {
+        nameProp = fetchNameProperty(XCB_ATOM_WM_NAME);
+    }
+    return readName(nameProp);
+}
+
+QString Client::readName(Xcb::Property &nameProp) const
 {
     if (info->name() && info->name()[0] != '\0')
         return QString::fromUtf8(info->name()).simplified();
     else {
-        return readNameProperty(window(), XCB_ATOM_WM_NAME);
+        return readNameProperty(nameProp);
     }
 }
 
@@ -1488,12 +1502,21 @@ void Client::updateCaption()
 }
 
 void Client::fetchIconicName()
+{
+    Xcb::Property iconNameProp;
+    if (!info->iconName() || info->iconName()[0] == '\0') {
+        iconNameProp = fetchNameProperty(XCB_ATOM_WM_ICON_NAME);
+    }
+    readIconicName(iconNameProp);
+}
+
+void Client::readIconicName(Xcb::Property &iconNameProp)
 {
     QString s;
     if (info->iconName() && info->iconName()[0] != '\0')
         s = QString::fromUtf8(info->iconName());
     else
-        s = readNameProperty(window(), XCB_ATOM_WM_ICON_NAME);
+        s = readNameProperty(iconNameProp);
     if (s != cap_iconic) {
         bool was_set = !cap_iconic.isEmpty();
         cap_iconic = s;
@@ -1692,13 +1715,23 @@ void Client::getIcons()
 }
 
 void Client::getSyncCounter()
+{
+    Xcb::Property syncProp = fetchSyncCounter();
+    readSyncCounter(syncProp);
+}
+
+Xcb::Property Client::fetchSyncCounter() const
 {
     // TODO: make sync working on XWayland
     static const bool isX11 = kwinApp()->operationMode() == Application::OperationModeX11;
     if (!Xcb::Extensions::self()->isSyncAvailable() || !isX11)
-        return;
+        return Xcb::Property();
 
-    Xcb::Property syncProp(false, window(), atoms->net_wm_sync_request_counter, XCB_ATOM_CARDINAL, 0, 1);
+    return Xcb::Property(false, window(), atoms->net_wm_sync_request_counter, XCB_ATOM_CARDINAL, 0, 1);
+}
+
+void Client::readSyncCounter(Xcb::Property &syncProp)
+{
     const xcb_sync_counter_t counter = syncProp.value<xcb_sync_counter_t>(XCB_NONE);
     if (counter != XCB_NONE) {
         syncRequest.counter = counter;
@@ -214,6 +214,18 @@ public:
     void finishCompositing(ReleaseReason releaseReason = ReleaseReason::Release) override;
     void setBlockingCompositing(bool block);
     inline bool isBlockingCompositing() { return blocks_compositing; }
+    /**
+     * Whether the window is an opaque fullscreen window which nothing is painted above,
+     * so that it can bypass compositing.
+     **/
+    bool shouldUnredirect() const;
+    /**
+     * Whether the window bypasses compositing. Managed by the Compositor.
+     **/
+    bool isUnredirected() const {
+        return m_unredirected;
+    }
+    void setUnredirected(bool unredirected);
 
     QString captionNormal() const override {
         return cap_normal;
@@ -443,6 +455,9 @@ private:
     void fetchName();
     void fetchIconicName();
     QString readName() const;
+    Xcb::Property fetchNameProperty(xcb_atom_t atom) const;
+    QString readName(Xcb::Property &nameProp) const;
+    void readIconicName(Xcb::Property &iconNameProp);
     void setCaption(const QString& s, bool force = false);
     bool hasTransientInternal(const Client* c, bool indirect, ConstClientList& set) const;
     void setShortcutInternal() override;
@@ -451,6 +466,8 @@ private:
     NETExtendedStrut strut() const;
     int checkShadeGeometry(int w, int h);
     void getSyncCounter();
+    Xcb::Property fetchSyncCounter() const;
+    void readSyncCounter(Xcb::Property &prop);
     void sendSyncRequest();
     void leaveMoveResize() override;
     void positionGeometryTip() override;
@@ -541,6 +558,7 @@ private:
     uint app_noborder : 1; ///< App requested no border via window type, shape extension, etc.
     uint ignore_focus_stealing : 1; ///< Don't apply focus stealing prevention to this client
     bool blocks_compositing;
+    bool m_unredirected = false;
     // DON'T reorder - Saved to config files !!!
     enum FullScreenMode {
         FullScreenNone,
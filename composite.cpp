@@ -31,6 +31,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "scene.h"
 #include "screens.h"
 #include "shadow.h"
+#include "texturememorymanager.h"
 #include "useractions.h"
 #include "xcbutils.h"
 #include "platform.h"
@@ -99,6 +100,7 @@ Compositor::Compositor(QObject* workspace)
     qRegisterMetaType<Compositor::SuspendReason>("Compositor::SuspendReason");
     connect(&compositeResetTimer, SIGNAL(timeout()), SLOT(restart()));
     connect(options, &Options::configChanged, this, &Compositor::slotConfigChanged);
+    TextureMemoryManager::create(this);
     compositeResetTimer.setSingleShot(true);
     nextPaintReference.invalidate(); // Initialize the timer
 
@@ -113,6 +115,17 @@ Compositor::Compositor(QObject* workspace)
     m_unusedSupportPropertyTimer.setSingleShot(true);
     connect(&m_unusedSupportPropertyTimer, SIGNAL(timeout()), SLOT(deleteUnusedSupportProperties()));
 
+    // unredirection is evaluated in performCompositing
+    m_unredirectTimer.setSingleShot(true);
+    connect(&m_unredirectTimer, &QTimer::timeout, this, &Compositor::scheduleRepaint);
+    connect(options, &Options::unredirectFullscreenChanged, this, &Compositor::scheduleRepaint);
+    connect(screens(), &Screens::changed, this,
+        [this] {
+            // resizing the overlay window resets its shape
+            redirectClient(m_unredirectedClient);
+        }
+    );
+
     // delay the call to setup by one event cycle
     // The ctor of this class is invoked from the Workspace ctor, that means before
     // Workspace is completely constructed, so calling Workspace::self() would result
@@ -298,6 +311,8 @@ void Compositor::startupWithWorkspace()
     scheduleRepaint();
     new EffectsHandlerImpl(this, m_scene);   // sets also the 'effects' pointer
     connect(Workspace::self(), &Workspace::deletedRemoved, m_scene, &Scene::windowDeleted);
+    connect(Workspace::self(), &Workspace::clientRemoved, this, &Compositor::redirectClient, Qt::UniqueConnection);
+    connect(Workspace::self(), &Workspace::clientActivated, this, &Compositor::scheduleRepaint, Qt::UniqueConnection);
     connect(effects, SIGNAL(screenGeometryChanged(QSize)), SLOT(addRepaintFull()));
     addRepaintFull();
     foreach (Client * c, Workspace::self()->clientList()) {
@@ -346,6 +361,11 @@ void Compositor::finish()
         return;
     m_finishing = true;
     m_releaseSelectionTimer.start();
+    m_unredirectCandidate = nullptr;
+    if (m_unredirectedClient) {
+        m_unredirectedClient->setUnredirected(false);
+        m_unredirectedClient = nullptr;
+    }
     if (Workspace::self()) {
         foreach (Client * c, Workspace::self()->clientList())
             m_scene->windowClosed(c, NULL);
@@ -657,13 +677,11 @@ void Compositor::performCompositing()
         return;
     }
 
-    // Create a list of all windows in the stacking order
-    ToplevelList windows = Workspace::self()->xStackingOrder();
     ToplevelList damaged;
 
-    // Reset the damage state of each window and fetch the damage region
-    // without waiting for a reply
-    foreach (Toplevel *win, windows) {
+    // Reset the damage state of each window which changed since the last frame
+    // and fetch the damage region without waiting for a reply
+    for (Toplevel *win : qAsConst(m_dirtyWindows)) {
         if (win->resetAndFetchDamage())
             damaged << win;
     }
@@ -675,13 +693,6 @@ void Compositor::performCompositing()
         }
     }
 
-    // Move elevated windows to the top of the stacking order
-    foreach (EffectWindow *c, static_cast<EffectsHandlerImpl *>(effects)->elevatedWindows()) {
-        Toplevel* t = static_cast< EffectWindowImpl* >(c)->window();
-        windows.removeAll(t);
-        windows.append(t);
-    }
-
     // Get the replies
     foreach (Toplevel *win, damaged) {
         // Discard the cached lanczos texture
@@ -696,33 +707,26 @@ void Compositor::performCompositing()
         win->getDamageRegionReply();
     }
 
+    updateUnredirection();
+
+    // all damage got fetched, windows without repaints have nothing left to do
+    for (auto it = m_dirtyWindows.begin(); it != m_dirtyWindows.end();) {
+        if ((*it)->repaints().isEmpty()) {
+            it = m_dirtyWindows.erase(it);
+        } else {
+            ++it;
+        }
+    }
+
     if (repaints_region.isEmpty() && !windowRepaintsPending()) {
         m_scene->idle();
         m_timeSinceLastVBlank = fpsInterval - (options->vBlankTime() + 1); // means "start now"
         m_timeSinceStart += m_timeSinceLastVBlank;
-        // Note: It would seem here we should undo suspended unredirect, but when scenes need
-        // it for some reason, e.g. transformations or translucency, the next pass that does not
-        // need this anymore and paints normally will also reset the suspended unredirect.
-        // Otherwise the window would not be painted normally anyway.
         compositeTimer.stop();
         return;
     }
 
-    // skip windows that are not yet ready for being painted and if screen is locked skip windows that are
-    // neither lockscreen nor inputmethod windows
-    // TODO ?
-    // this cannot be used so carelessly - needs protections against broken clients, the window
-    // should not get focus before it's displayed, handle unredirected windows properly and so on.
-    foreach (Toplevel *t, windows) {
-        if (!t->readyForPainting()) {
-            windows.removeAll(t);
-        }
-        if (waylandServer() && waylandServer()->isScreenLocked()) {
-            if(!t->isLockScreen() && !t->isInputMethod()) {
-                windows.removeAll(t);
-            }
-        }
-    }
+    const ToplevelList windows = paintableWindows();
 
     QRegion repaints = repaints_region;
     // clear all repaints, so that post-pass can add repaints for the next repaint
@@ -764,43 +768,171 @@ void Compositor::performCompositing()
     }
 }
 
-template <class T>
-static bool repaintsPending(const QList<T*> &windows)
+bool Compositor::windowRepaintsPending() const
 {
-    return std::any_of(windows.begin(), windows.end(), [] (T *t) { return !t->repaints().isEmpty(); });
+    // only windows with repaints are left in the dirty windows at this point
+    return std::any_of(m_dirtyWindows.begin(), m_dirtyWindows.end(),
+        [this] (Toplevel *t) {
+            if (isHiddenByUnredirectedClient(t)) {
+                return false;
+            }
+            if (ShellClient *c = qobject_cast<ShellClient*>(t)) {
+                return c->isInternal() ? c->isShown(true) : c->readyForPainting();
+            }
+            return true;
+        }
+    );
 }
 
-bool Compositor::windowRepaintsPending() const
+ToplevelList Compositor::paintableWindows() const
 {
-    if (repaintsPending(Workspace::self()->clientList())) {
-        return true;
-    }
-    if (repaintsPending(Workspace::self()->desktopList())) {
-        return true;
+    const ToplevelList &stacking = Workspace::self()->xStackingOrder();
+    const auto elevated = static_cast<EffectsHandlerImpl *>(effects)->elevatedWindows();
+    const bool screenLocked = waylandServer() && waylandServer()->isScreenLocked();
+
+    // skip windows that are not yet ready for being painted and if screen is locked skip windows that are
+    // neither lockscreen nor inputmethod windows
+    // TODO ?
+    // this cannot be used so carelessly - needs protections against broken clients, the window
+    // should not get focus before it's displayed, handle unredirected windows properly and so on.
+    auto isPaintable = [screenLocked] (Toplevel *t) {
+        if (!t->readyForPainting()) {
+            return false;
+        }
+        return !screenLocked || t->isLockScreen() || t->isInputMethod();
+    };
+
+    ToplevelList windows;
+    windows.reserve(stacking.count());
+    for (Toplevel *t : stacking) {
+        if (isHiddenByUnredirectedClient(t)) {
+            continue;
+        }
+        if (!elevated.isEmpty() && t->effectWindow() && elevated.contains(t->effectWindow())) {
+            // elevated windows are moved to the top of the stacking order
+            continue;
+        }
+        if (isPaintable(t)) {
+            windows << t;
+        }
     }
-    if (repaintsPending(Workspace::self()->unmanagedList())) {
-        return true;
+    for (EffectWindow *c : elevated) {
+        Toplevel* t = static_cast< EffectWindowImpl* >(c)->window();
+        if (isPaintable(t)) {
+            windows << t;
+        }
     }
-    if (repaintsPending(Workspace::self()->deletedList())) {
-        return true;
+    return windows;
+}
+
+// how long a Client has to be the candidate for unredirection before it gets unredirected
+static const qint64 s_unredirectDelay = 500;
+
+void Compositor::updateUnredirection()
+{
+    if (!m_scene->overlayWindow() || m_scene->overlayWindow()->window() == XCB_WINDOW_NONE) {
+        return;
     }
-    if (auto w = waylandServer()) {
-        const auto &clients = w->clients();
-        auto test = [] (ShellClient *c) {
-            return c->readyForPainting() && !c->repaints().isEmpty();
-        };
-        if (std::any_of(clients.begin(), clients.end(), test)) {
-            return true;
+    Client *candidate = nullptr;
+    // effects like zoom or a screenshot paint on top of or read back the screen,
+    // which does not show anything of an unredirected window
+    if (options->isUnredirectFullscreen() && !effects->activeFullScreenEffect()
+            && !static_cast<EffectsHandlerImpl *>(effects)->hasActiveEffectsOnTop()
+            && static_cast<EffectsHandlerImpl *>(effects)->elevatedWindows().isEmpty()) {
+        candidate = qobject_cast<Client*>(Workspace::self()->activeClient());
+        if (candidate && !candidate->shouldUnredirect()) {
+            candidate = nullptr;
         }
-        const auto &internalClients = w->internalClients();
-        auto internalTest = [] (ShellClient *c) {
-            return c->isShown(true) && !c->repaints().isEmpty();
-        };
-        if (std::any_of(internalClients.begin(), internalClients.end(), internalTest)) {
-            return true;
+    }
+    if (candidate == m_unredirectedClient) {
+        m_unredirectCandidate = nullptr;
+        return;
+    }
+    // composite right away, something has to be painted on top of the window
+    setUnredirectedClient(nullptr);
+    if (!candidate) {
+        m_unredirectCandidate = nullptr;
+        return;
+    }
+    if (m_unredirectCandidate != candidate) {
+        m_unredirectCandidate = candidate;
+        m_unredirectCandidateTimer.start();
+    }
+    const qint64 remaining = s_unredirectDelay - m_unredirectCandidateTimer.elapsed();
+    if (remaining > 0) {
+        // check again once the delay passed, even if nothing gets repainted till then
+        if (!m_unredirectTimer.isActive()) {
+            m_unredirectTimer.start(remaining);
         }
+        return;
+    }
+    m_unredirectCandidate = nullptr;
+    setUnredirectedClient(candidate);
+}
+
+void Compositor::setUnredirectedClient(Client *client)
+{
+    if (m_unredirectedClient == client) {
+        return;
+    }
+    if (m_unredirectedClient) {
+        disconnect(m_unredirectedGeometryConnection);
+        m_unredirectedClient->setUnredirected(false);
+    }
+    m_unredirectedClient = client;
+    if (client) {
+        client->setUnredirected(true);
+        // the overlay window's shape only has a hole at the current geometry, composite
+        // again and let updateUnredirection pick the window up at its new place
+        m_unredirectedGeometryConnection = connect(client, &Toplevel::geometryChanged, this,
+            [this] {
+                setUnredirectedClient(nullptr);
+            }
+        );
+    }
+    if (!hasScene() || !m_scene->overlayWindow()) {
+        return;
+    }
+    // cut the unredirected window out of the overlay window, so that it is actually visible
+    const QSize &s = screens()->size();
+    QRegion shape(0, 0, s.width(), s.height());
+    if (client) {
+        shape -= client->geometry();
+    } else {
+        addRepaintFull();
+    }
+    m_scene->overlayWindow()->setShape(shape);
+}
+
+void Compositor::redirectClient(AbstractClient *client)
+{
+    if (!client) {
+        return;
+    }
+    if (client == m_unredirectCandidate) {
+        m_unredirectCandidate = nullptr;
+    }
+    if (client == m_unredirectedClient) {
+        setUnredirectedClient(nullptr);
     }
-    return false;
+}
+
+bool Compositor::isHiddenByUnredirectedClient(Toplevel *window) const
+{
+    if (!m_unredirectedClient) {
+        return false;
+    }
+    return window == m_unredirectedClient || m_unredirectedClient->geometry().contains(window->visibleRect());
+}
+
+void Compositor::addDirtyWindow(Toplevel *window)
+{
+    m_dirtyWindows.insert(window);
+}
+
+void Compositor::removeDirtyWindow(Toplevel *window)
+{
+    m_dirtyWindows.remove(window);
 }
 
 void Compositor::setCompositeResetTimer(int msecs)
@@ -974,9 +1106,17 @@ void Toplevel::discardWindowPixmap()
         effectWindow()->sceneWindow()->pixmapDiscarded();
 }
 
+void Toplevel::markAsDirty()
+{
+    if (Compositor *c = Compositor::self()) {
+        c->addDirtyWindow(this);
+    }
+}
+
 void Toplevel::damageNotifyEvent()
 {
     m_isDamaged = true;
+    markAsDirty();
 
     // Note: The rect is supposed to specify the damage extents,
     //       but we don't know it at this point. No one who connects
@@ -994,9 +1134,16 @@ bool Toplevel::compositing() const
 
 void Client::damageNotifyEvent()
 {
+    if (m_unredirected) {
+        // the window is not composited, so the damage is of no interest
+        xcb_damage_subtract(connection(), damageHandle(), XCB_NONE, XCB_NONE);
+        return;
+    }
+
     if (syncRequest.isPending && isResize()) {
         emit damaged(this, QRect());
         m_isDamaged = true;
+        markAsDirty();
         return;
     }
 
@@ -1083,6 +1230,7 @@ void Toplevel::addDamageFull()
 
     damage_region = rect();
     repaints_region |= rect();
+    markAsDirty();
 
     emit damaged(this, rect());
 }
@@ -1098,6 +1246,7 @@ void Toplevel::addRepaint(const QRect& r)
         return;
     }
     repaints_region += r;
+    markAsDirty();
     emit needsRepaint();
 }
 
@@ -1113,6 +1262,7 @@ void Toplevel::addRepaint(const QRegion& r)
         return;
     }
     repaints_region += r;
+    markAsDirty();
     emit needsRepaint();
 }
 
@@ -1122,6 +1272,7 @@ void Toplevel::addLayerRepaint(const QRect& r)
         return;
     }
     layer_repaints_region += r;
+    markAsDirty();
     emit needsRepaint();
 }
 
@@ -1136,12 +1287,14 @@ void Toplevel::addLayerRepaint(const QRegion& r)
     if (!compositing())
         return;
     layer_repaints_region += r;
+    markAsDirty();
     emit needsRepaint();
 }
 
 void Toplevel::addRepaintFull()
 {
     repaints_region = visibleRect().translated(-pos());
+    markAsDirty();
     emit needsRepaint();
 }
 
@@ -1179,6 +1332,63 @@ bool Client::setupCompositing()
     return true;
 }
 
+static bool coversFromAbove(Toplevel *t, const QRect &rect)
+{
+    if (!t->isOnCurrentDesktop() || !t->isOnCurrentActivity()) {
+        return false;
+    }
+    if (AbstractClient *c = qobject_cast<AbstractClient*>(t)) {
+        if (!c->isShown(true)) {
+            return false;
+        }
+    }
+    // includes e.g. the shadow, Deleted windows are still animated
+    return t->visibleRect().intersects(rect);
+}
+
+bool Client::shouldUnredirect() const
+{
+    if (!readyForPainting() || !isShown(true) || !isOnCurrentDesktop() || !isOnCurrentActivity()) {
+        return false;
+    }
+    if (!isFullScreen() || geometry() != screens()->geometry(screen())) {
+        return false;
+    }
+    if (shape() || hasAlpha() || opacity() != 1.0) {
+        return false;
+    }
+    if (rules()->checkDisableUnredirect(false)) {
+        return false;
+    }
+    // nothing may be painted on top of the window
+    const ToplevelList &stacking = workspace()->xStackingOrder();
+    for (auto it = stacking.crbegin(); it != stacking.crend(); ++it) {
+        if (*it == this) {
+            return true;
+        }
+        if (coversFromAbove(*it, geometry())) {
+            return false;
+        }
+    }
+    return false;
+}
+
+void Client::setUnredirected(bool unredirected)
+{
+    if (m_unredirected == unredirected) {
+        return;
+    }
+    m_unredirected = unredirected;
+    if (unredirected) {
+        qCDebug(KWIN_CORE) << "Unredirecting:" << this;
+        xcb_composite_unredirect_window(connection(), frameId(), XCB_COMPOSITE_REDIRECT_MANUAL);
+    } else {
+        qCDebug(KWIN_CORE) << "Redirecting:" << this;
+        xcb_composite_redirect_window(connection(), frameId(), XCB_COMPOSITE_REDIRECT_MANUAL);
+        discardWindowPixmap();
+    }
+}
+
 void Client::finishCompositing(ReleaseReason releaseReason)
 {
     Toplevel::finishCompositing(releaseReason);
@@ -31,11 +31,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QTimer>
 #include <QBasicTimer>
 #include <QRegion>
+#include <QSet>
 
 namespace KWin {
 
+class AbstractClient;
 class Client;
 class Scene;
+class Toplevel;
 
 class CompositorSelectionOwner : public KSelectionOwner
 {
@@ -110,6 +113,14 @@ public:
     void keepSupportProperty(xcb_atom_t atom);
     void removeSupportProperty(xcb_atom_t atom);
 
+    /**
+     * Remembers that @p window got damaged or has repaints, so that the next frame
+     * only needs to look at the windows which changed.
+     * Invoked by Toplevel, there is no need to call it manually.
+     **/
+    void addDirtyWindow(Toplevel *window);
+    void removeDirtyWindow(Toplevel *window);
+
 public Q_SLOTS:
     void addRepaintFull();
     /**
@@ -198,11 +209,23 @@ private Q_SLOTS:
     void slotConfigChanged();
     void releaseCompositorSelection();
     void deleteUnusedSupportProperties();
+    void redirectClient(KWin::AbstractClient *client);
 
 private:
     void claimCompositorSelection();
     void setCompositeTimer();
     bool windowRepaintsPending() const;
+    QList<Toplevel*> paintableWindows() const;
+    /**
+     * Lets the active fullscreen Client bypass compositing on X11 if nothing needs to be
+     * composited on top of it, and composites it again otherwise.
+     **/
+    void updateUnredirection();
+    void setUnredirectedClient(Client *client);
+    /**
+     * Whether @p window is hidden behind the unredirected Client and thus need not be painted.
+     **/
+    bool isHiddenByUnredirectedClient(Toplevel *window) const;
     /**
      * Continues the startup after Scene And Workspace are created
      **/
@@ -223,6 +246,19 @@ private:
     int m_xrrRefreshRate;
     QElapsedTimer nextPaintReference;
     QRegion repaints_region;
+    /**
+     * Windows which got damaged or have repaints since the last frame.
+     **/
+    QSet<Toplevel*> m_dirtyWindows;
+    Client *m_unredirectedClient = nullptr;
+    QMetaObject::Connection m_unredirectedGeometryConnection;
+    /**
+     * The Client which could be unredirected, it only gets unredirected once it stayed
+     * the candidate for a while, so that e.g. a short animation does not cause flicker.
+     **/
+    Client *m_unredirectCandidate = nullptr;
+    QElapsedTimer m_unredirectCandidateTimer;
+    QTimer m_unredirectTimer;
 
     QTimer compositeResetTimer; // for compressing composite resets
     bool m_finishing; // finish() sets this variable while shutting down
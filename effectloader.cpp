@@ -34,6 +34,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QtConcurrentRun>
 #include <QDebug>
 #include <QFutureWatcher>
+#include <QJsonObject>
 #include <QMap>
 #include <QStringList>
 
@@ -74,6 +75,16 @@ LoadEffectFlags AbstractEffectLoader::readConfig(const QString &effectName, bool
     return LoadEffectFlags();
 }
 
+bool AbstractEffectLoader::isLoadedOnDemand(const KPluginMetaData &effect)
+{
+    // converted desktop files store the value as a string
+    const QJsonValue value = effect.rawData().value(QStringLiteral("X-KWin-Load-On-Demand"));
+    if (value.isBool()) {
+        return value.toBool();
+    }
+    return value.toString().compare(QLatin1String("true"), Qt::CaseInsensitive) == 0;
+}
+
 BuiltInEffectLoader::BuiltInEffectLoader(QObject *parent)
     : AbstractEffectLoader(parent)
     , m_queue(new EffectLoadQueue<BuiltInEffectLoader, BuiltInEffect>(this))
@@ -115,7 +126,7 @@ void BuiltInEffectLoader::queryAndLoadAll()
         const QString key = BuiltInEffects::nameForEffect(effect);
         const LoadEffectFlags flags = readConfig(key, BuiltInEffects::enabledByDefault(effect));
         if (flags.testFlag(LoadEffectFlag::Load)) {
-            m_queue->enqueue(qMakePair(effect, flags));
+            m_queue->enqueue(qMakePair(effect, flags), BuiltInEffects::effectData(effect).loadedOnDemand);
         }
     }
 }
@@ -277,7 +288,7 @@ void ScriptedEffectLoader::queryAndLoadAll()
             for (auto effect : effects) {
                 const LoadEffectFlags flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
                 if (flags.testFlag(LoadEffectFlag::Load)) {
-                    m_queue->enqueue(qMakePair(effect, flags));
+                    m_queue->enqueue(qMakePair(effect, flags), isLoadedOnDemand(effect));
                 }
             }
             watcher->deleteLater();
@@ -456,7 +467,7 @@ void PluginEffectLoader::queryAndLoadAll()
             for (const auto &effect : effects) {
                 const LoadEffectFlags flags = readConfig(effect.pluginId(), effect.isEnabledByDefault());
                 if (flags.testFlag(LoadEffectFlag::Load)) {
-                    m_queue->enqueue(qMakePair(effect, flags));
+                    m_queue->enqueue(qMakePair(effect, flags), isLoadedOnDemand(effect));
                 }
             }
             watcher->deleteLater();
@@ -193,6 +193,12 @@ protected:
      * @returns Flags indicating whether the Effect should be loaded and how it should be loaded
      */
     LoadEffectFlags readConfig(const QString &effectName, bool defaultValue) const;
+    /**
+     * Whether the plugin or scripted Effect described by @p effect does nothing till the user
+     * activates it, e.g. through a shortcut or a screen edge. Such Effects are loaded after all
+     * others. Effects opt in through the metadata key X-KWin-Load-On-Demand.
+     **/
+    static bool isLoadedOnDemand(const KPluginMetaData &effect);
 
 private:
     KSharedConfig::Ptr m_config;
@@ -213,6 +219,8 @@ private:
  * EffectLoadQueue inheriting from AbstractEffectLoadQueue.
  *
  * The queue operates like a normal queue providing enqueue and a scheduleDequeue instead of dequeue.
+ * Effects which are only activated on demand by the user are kept in a second queue which is only
+ * processed once all other Effects are loaded.
  *
  */
 class AbstractEffectLoadQueue : public QObject
@@ -237,31 +245,36 @@ public:
         , m_dequeueScheduled(false)
     {
     }
-    void enqueue(const QPair<QueueType, LoadEffectFlags> value)
+    void enqueue(const QPair<QueueType, LoadEffectFlags> value, bool onDemand = false)
     {
-        m_queue.enqueue(value);
+        if (onDemand) {
+            m_onDemandQueue.enqueue(value);
+        } else {
+            m_queue.enqueue(value);
+        }
         scheduleDequeue();
     }
     void clear()
     {
         m_queue.clear();
+        m_onDemandQueue.clear();
         m_dequeueScheduled = false;
     }
 protected:
     void dequeue() override
     {
-        if (m_queue.isEmpty()) {
+        if (m_queue.isEmpty() && m_onDemandQueue.isEmpty()) {
             return;
         }
         m_dequeueScheduled = false;
-        const auto pair = m_queue.dequeue();
+        const auto pair = m_queue.isEmpty() ? m_onDemandQueue.dequeue() : m_queue.dequeue();
         m_effectLoader->loadEffect(pair.first, pair.second);
         scheduleDequeue();
     }
 private:
     void scheduleDequeue()
     {
-        if (m_queue.isEmpty() || m_dequeueScheduled) {
+        if ((m_queue.isEmpty() && m_onDemandQueue.isEmpty()) || m_dequeueScheduled) {
             return;
         }
         m_dequeueScheduled = true;
@@ -270,6 +283,7 @@ private:
     Loader *m_effectLoader;
     bool m_dequeueScheduled;
     QQueue<QPair<QueueType, LoadEffectFlags>> m_queue;
+    QQueue<QPair<QueueType, LoadEffectFlags>> m_onDemandQueue;
 };
 
 /**
@@ -49,6 +49,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QDebug>
 #include <QDesktopWidget>
+#include <QTimer>
 
 #include <Plasma/Theme>
 
@@ -67,6 +68,9 @@ namespace KWin
 //---------------------
 // Static
 
+// in case no frame gets painted, e.g. because the overlay window is hidden
+static const int s_loadEffectsTimeout = 500;
+
 static QByteArray readWindowProperty(xcb_window_t win, xcb_atom_t atom, xcb_atom_t type, int format)
 {
     if (win == XCB_WINDOW_NONE) {
@@ -256,7 +260,9 @@ EffectsHandlerImpl::EffectsHandlerImpl(Compositor *compositor, Scene *scene)
             }
         );
     }
-    reconfigure();
+    // the first frame gets painted without the effects, they are loaded once it is done, see startPaint
+    m_loadEffectsPending = true;
+    QTimer::singleShot(s_loadEffectsTimeout, this, &EffectsHandlerImpl::loadPendingEffects);
 }
 
 EffectsHandlerImpl::~EffectsHandlerImpl()
@@ -358,9 +364,17 @@ void EffectsHandlerImpl::setupUnmanagedConnections(Unmanaged* u)
 
 void EffectsHandlerImpl::reconfigure()
 {
+    m_loadEffectsPending = false;
     m_effectLoader->queryAndLoadAll();
 }
 
+void EffectsHandlerImpl::loadPendingEffects()
+{
+    if (m_loadEffectsPending) {
+        reconfigure();
+    }
+}
+
 // the idea is that effects call this function again which calls the next one
 void EffectsHandlerImpl::prePaintScreen(ScreenPrePaintData& data, int time)
 {
@@ -493,6 +507,10 @@ bool EffectsHandlerImpl::decorationSupportsBlurBehind() const
 // start another painting pass
 void EffectsHandlerImpl::startPaint()
 {
+    if (m_loadEffectsPending) {
+        // the timer fires after this frame is painted
+        QTimer::singleShot(0, this, &EffectsHandlerImpl::loadPendingEffects);
+    }
     m_activeEffects.clear();
     m_activeEffects.reserve(loaded_effects.count());
     for(QVector< KWin::EffectPair >::const_iterator it = loaded_effects.constBegin(); it != loaded_effects.constEnd(); ++it) {
@@ -838,6 +856,16 @@ xcb_atom_t EffectsHandlerImpl::announceSupportProperty(const QByteArray &propert
     m_compositor->keepSupportProperty(atom);
     m_managedProperties.insert(propertyName, atom);
     registerPropertyType(atom, true);
+    // effects usually read a newly announced property for all windows,
+    // request it for all of them at once so that the replies are available by then
+    if (Workspace *ws = Workspace::self()) {
+        for (Client *c : ws->clientList()) {
+            c->prefetchProperty(atom);
+        }
+        for (Unmanaged *u : ws->unmanagedList()) {
+            u->prefetchProperty(atom);
+        }
+    }
     return atom;
 }
 
@@ -1469,6 +1497,18 @@ QStringList EffectsHandlerImpl::activeEffects() const
     return ret;
 }
 
+bool EffectsHandlerImpl::hasActiveEffectsOnTop() const
+{
+    return std::any_of(loaded_effects.constBegin(), loaded_effects.constEnd(),
+        [] (const EffectPair &pair) {
+            if (pair.second->provides(Effect::Blur) || pair.second->provides(Effect::Contrast)) {
+                return false;
+            }
+            return pair.second->isActive();
+        }
+    );
+}
+
 KWayland::Server::Display *EffectsHandlerImpl::waylandDisplay() const
 {
     if (waylandServer()) {
@@ -1706,7 +1746,7 @@ QByteArray EffectWindowImpl::readProperty(long atom, long type, int format) cons
     if (!kwinApp()->x11Connection()) {
         return QByteArray();
     }
-    return readWindowProperty(window()->window(), atom, type, format);
+    return toplevel->readProperty(atom, type, format);
 }
 
 void EffectWindowImpl::deleteProperty(long int atom) const
@@ -212,6 +212,11 @@ public:
 
     QList<EffectWindow*> elevatedWindows() const;
     QStringList activeEffects() const;
+    /**
+     * @returns whether any of the loaded effects is active and may paint on top of the windows
+     * or read back the screen. Effects which only paint behind windows like blur are ignored.
+     **/
+    bool hasActiveEffectsOnTop() const;
 
     /**
      * @returns Whether we are currently in a desktop rendering process triggered by paintDesktop hook
@@ -303,6 +308,10 @@ protected:
 
 private:
     void registerPropertyType(long atom, bool reg);
+    /**
+     * Starts loading the effects if that did not yet happen.
+     **/
+    void loadPendingEffects();
     typedef QVector< Effect*> EffectsList;
     typedef EffectsList::const_iterator EffectsIterator;
     EffectsList m_activeEffects;
@@ -322,6 +331,7 @@ private:
     QList<Effect*> m_grabbedMouseEffects;
     EffectLoader *m_effectLoader;
     int m_trackingCursorChanges;
+    bool m_loadEffectsPending = false;
     std::unique_ptr<EffectsMouseInterceptionX11Filter> m_x11MouseInterception;
     std::unique_ptr<WindowPropertyNotifyX11Filter> m_x11WindowPropertyNotify;
 };
@@ -94,6 +94,7 @@ static const QVector<EffectData> s_effectData = {
         QUrl(),
         false,
         false,
+        false,
         nullptr,
         nullptr,
         nullptr
@@ -106,6 +107,7 @@ static const QVector<EffectData> s_effectData = {
         QUrl(),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<BlurEffect>,
         &BlurEffect::supported,
@@ -121,6 +123,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         true,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<ColorPickerEffect>,
         &ColorPickerEffect::supported,
@@ -136,6 +139,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ContrastEffect>,
         &ContrastEffect::supported,
@@ -151,6 +155,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/cover_switch.mp4")),
         false,
         true,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<CoverSwitchEffect>,
         &CoverSwitchEffect::supported,
@@ -166,6 +171,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/desktop_cube.ogv")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<CubeEffect>,
         &CubeEffect::supported,
@@ -181,6 +187,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/desktop_cube_animation.ogv")),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<CubeSlideEffect>,
         &CubeSlideEffect::supported,
@@ -196,6 +203,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/desktop_grid.mp4")),
         true,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<DesktopGridEffect>,
         nullptr,
@@ -211,6 +219,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/dim_inactive.mp4")),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<DimInactiveEffect>,
         nullptr,
@@ -226,6 +235,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/dim_administration.mp4")),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<DimScreenEffect>,
         nullptr,
@@ -241,6 +251,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<FallApartEffect>,
         &FallApartEffect::supported,
@@ -256,6 +267,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/flip_switch.mp4")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<FlipSwitchEffect>,
         &FlipSwitchEffect::supported,
@@ -271,6 +283,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<GlideEffect>,
         &GlideEffect::supported,
@@ -286,6 +299,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         true,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<HighlightWindowEffect>,
         nullptr,
@@ -301,6 +315,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/invert.mp4")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<InvertEffect>,
         &InvertEffect::supported,
@@ -316,6 +331,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         true,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<KscreenEffect>,
         nullptr,
@@ -331,6 +347,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/looking_glass.ogv")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<LookingGlassEffect>,
         &LookingGlassEffect::supported,
@@ -346,6 +363,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/magic_lamp.ogv")),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<MagicLampEffect>,
         &MagicLampEffect::supported,
@@ -361,6 +379,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/magnifier.ogv")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<MagnifierEffect>,
         &MagnifierEffect::supported,
@@ -376,6 +395,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/minimize.ogv")),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<MinimizeAnimationEffect>,
         nullptr,
@@ -391,6 +411,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/mouse_click.mp4")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<MouseClickEffect>,
         nullptr,
@@ -406,6 +427,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<MouseMarkEffect>,
         nullptr,
@@ -421,6 +443,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/present_windows.mp4")),
         true,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<PresentWindowsEffect>,
         nullptr,
@@ -436,6 +459,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<ResizeEffect>,
         nullptr,
@@ -451,6 +475,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ScreenEdgeEffect>,
         nullptr,
@@ -466,6 +491,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         true,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ScreenShotEffect>,
         &ScreenShotEffect::supported,
@@ -481,6 +507,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<SheetEffect>,
         &SheetEffect::supported,
@@ -496,6 +523,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ShowFpsEffect>,
         nullptr,
@@ -511,6 +539,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ShowPaintEffect>,
         nullptr,
@@ -526,6 +555,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/slide.ogv")),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<SlideEffect>,
         nullptr,
@@ -541,6 +571,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<SlideBackEffect>,
         nullptr,
@@ -556,6 +587,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/sliding_popups.mp4")),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<SlidingPopupsEffect>,
         nullptr,
@@ -571,6 +603,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/snap_helper.mp4")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<SnapHelperEffect>,
         nullptr,
@@ -586,6 +619,7 @@ EFFECT_FALLBACK
         QUrl(),
         true,
         true,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<StartupFeedbackEffect>,
         &StartupFeedbackEffect::supported,
@@ -601,6 +635,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ThumbnailAsideEffect>,
         nullptr,
@@ -616,6 +651,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<TouchPointsEffect>,
         nullptr,
@@ -631,6 +667,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/track_mouse.mp4")),
         false,
         false,
+        true,
 #ifdef EFFECT_BUILTINS
         &createHelper<TrackMouseEffect>,
         nullptr,
@@ -646,6 +683,7 @@ EFFECT_FALLBACK
         QUrl(),
         false,
         true,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<WindowGeometry>,
         nullptr,
@@ -661,6 +699,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/wobbly_windows.ogv")),
         false,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<WobblyWindowsEffect>,
         &WobblyWindowsEffect::supported,
@@ -676,6 +715,7 @@ EFFECT_FALLBACK
         QUrl(QStringLiteral("http://files.kde.org/plasma/kwin/effect-videos/zoom.ogv")),
         true,
         false,
+        false,
 #ifdef EFFECT_BUILTINS
         &createHelper<ZoomEffect>,
         nullptr,
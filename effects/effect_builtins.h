@@ -87,6 +87,11 @@ struct EffectData {
     QUrl video;
     bool enabled;
     bool internal;
+    /**
+     * The Effect does nothing till the user activates it, e.g. through a shortcut,
+     * thus it gets loaded after all other Effects.
+     **/
+    bool loadedOnDemand;
     std::function<Effect*()> createFunction;
     std::function<bool()> supportedFunction;
     std::function<bool()> enabledFunction;
@@ -19,6 +19,7 @@ You should have received a copy of the GNU General Public License
 along with this program.  If not, see <http://www.gnu.org/licenses/>.
 *********************************************************************/
 #include "screenshot.h"
+#include "screenshotstream.h"
 #include <kwinglplatform.h>
 #include <kwinglutils.h>
 #include <kwinxrenderutils.h>
@@ -50,6 +51,25 @@ const static QString s_errorInvalidArea = QStringLiteral("org.kde.kwin.Screensho
 const static QString s_errorInvalidAreaMsg = QStringLiteral("Invalid area requested");
 const static QString s_errorInvalidScreen = QStringLiteral("org.kde.kwin.Screenshot.Error.InvalidScreen");
 const static QString s_errorInvalidScreenMsg = QStringLiteral("Invalid screen requested");
+const static QString s_errorAlreadyStreaming = QStringLiteral("org.kde.kwin.Screenshot.Error.AlreadyStreaming");
+const static QString s_errorAlreadyStreamingMsg = QStringLiteral("A stream is already running");
+const static QString s_errorStream = QStringLiteral("org.kde.kwin.Screenshot.Error.Stream");
+const static QString s_errorStreamMsg = QStringLiteral("Could not create the shared memory for the stream");
+
+/**
+ * Writes @p img into @p fd and closes it, to be run in a thread.
+ **/
+static void writeImage(int fd, const QImage &img)
+{
+    QFile file;
+    if (file.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
+        QDataStream ds(&file);
+        ds << img;
+        file.close();
+    } else {
+        close(fd);
+    }
+}
 
 bool ScreenShotEffect::supported()
 {
@@ -57,16 +77,37 @@ bool ScreenShotEffect::supported()
             (effects->isOpenGLCompositing() && GLRenderTarget::supported());
 }
 
+struct ScreenShotReadback
+{
+    GLuint buffer = 0;
+    GLsync fence = nullptr;
+    QSize size;
+    int fd = -1;
+    QImage cursor;
+    QPoint cursorPos;
+};
+
 ScreenShotEffect::ScreenShotEffect()
     : m_scheduledScreenshot(0)
+    , m_streamWatcher(new QDBusServiceWatcher(this))
 {
     connect ( effects, SIGNAL(windowClosed(KWin::EffectWindow*)), SLOT(windowClosed(KWin::EffectWindow*)) );
     QDBusConnection::sessionBus().registerObject(QStringLiteral("/Screenshot"), this, QDBusConnection::ExportScriptableContents);
+    // the GPU usually finishes the copy within a frame
+    m_readbackTimer.setInterval(5);
+    connect(&m_readbackTimer, &QTimer::timeout, this, &ScreenShotEffect::checkReadback);
+
+    m_streamWatcher->setConnection(QDBusConnection::sessionBus());
+    m_streamWatcher->setWatchMode(QDBusServiceWatcher::WatchForUnregistration);
+    connect(m_streamWatcher, &QDBusServiceWatcher::serviceUnregistered, this, &ScreenShotEffect::resetStream);
+    // the shared memory is sized for the screen
+    connect(effects, &EffectsHandler::virtualScreenGeometryChanged, this, &ScreenShotEffect::resetStream);
 }
 
 ScreenShotEffect::~ScreenShotEffect()
 {
     QDBusConnection::sessionBus().unregisterObject(QStringLiteral("/Screenshot"));
+    cancelReadback();
 }
 
 #ifdef KWIN_HAVE_XRENDER_COMPOSITING
@@ -90,12 +131,27 @@ static QImage xPictureToImage(xcb_render_picture_t srcPic, const QRect &geometry
 void ScreenShotEffect::paintScreen(int mask, QRegion region, ScreenPaintData &data)
 {
     m_cachedOutputGeometry = data.outputGeometry();
+    if (m_stream) {
+        m_streamDamage |= region & m_stream->geometry();
+    }
     effects->paintScreen(mask, region, data);
 }
 
+void ScreenShotEffect::prePaintWindow(EffectWindow *w, WindowPrePaintData &data, int time)
+{
+    effects->prePaintWindow(w, data, time);
+    if (m_stream) {
+        // the repaints of the windows are not part of the region passed to paintScreen
+        m_streamDamage |= data.paint & m_stream->geometry();
+    }
+}
+
 void ScreenShotEffect::postPaintScreen()
 {
     effects->postPaintScreen();
+    if (m_stream) {
+        captureStreamFrame();
+    }
     if (m_scheduledScreenshot) {
         WindowPaintData d(m_scheduledScreenshot);
         double left = 0;
@@ -196,17 +252,7 @@ void ScreenShotEffect::postPaintScreen()
             } else if (m_windowMode == WindowMode::File) {
                 sendReplyImage(img);
             } else if (m_windowMode == WindowMode::FileDescriptor) {
-                QtConcurrent::run(
-                    [] (int fd, const QImage &img) {
-                        QFile file;
-                        if (file.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
-                            QDataStream ds(&file);
-                            ds << img;
-                            file.close();
-                        } else {
-                            close(fd);
-                        }
-                    }, m_fd, img);
+                QtConcurrent::run(writeImage, m_fd, img);
                 m_windowMode = WindowMode::NoCapture;
                 m_fd = -1;
             }
@@ -227,6 +273,10 @@ void ScreenShotEffect::postPaintScreen()
                 // doesn't intersect, not going onto this screenshot
                 return;
             }
+            if (intersection == m_scheduledGeometry && m_fd != -1 && supportsAsyncReadback()) {
+                startReadback(intersection);
+                return;
+            }
             const QImage img = blitScreenshot(intersection);
             if (img.size() == m_scheduledGeometry.size()) {
                 // we are done
@@ -246,6 +296,8 @@ void ScreenShotEffect::postPaintScreen()
                 sendReplyImage(m_multipleOutputsImage);
             }
 
+        } else if (m_fd != -1 && supportsAsyncReadback()) {
+            startReadback(m_scheduledGeometry);
         } else {
             const QImage img = blitScreenshot(m_scheduledGeometry);
             sendReplyImage(img);
@@ -253,20 +305,116 @@ void ScreenShotEffect::postPaintScreen()
     }
 }
 
+bool ScreenShotEffect::supportsAsyncReadback()
+{
+    if (!effects->isOpenGLCompositing() || !GLRenderTarget::blitSupported()) {
+        return false;
+    }
+    // needs fence syncs and glMapBufferRange
+    if (GLPlatform::instance()->isGLES()) {
+        return hasGLVersion(3, 0);
+    }
+    return hasGLVersion(3, 2);
+}
+
+void ScreenShotEffect::startReadback(const QRect &geometry)
+{
+    ScreenShotReadback *readback = new ScreenShotReadback;
+    readback->size = geometry.size();
+    readback->fd = m_fd;
+    if (m_captureCursor) {
+        const auto cursor = effects->cursorImage();
+        readback->cursor = cursor.image();
+        readback->cursorPos = effects->cursorPos() - cursor.hotSpot() - geometry.topLeft();
+    }
+
+    GLTexture tex(GL_RGBA8, geometry.width(), geometry.height());
+    GLRenderTarget target(tex);
+    target.blitFromFramebuffer(geometry);
+
+    // the copy into the buffer happens asynchronously, the texture is kept alive by the driver till then
+    glGenBuffers(1, &readback->buffer);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+    glBufferData(GL_PIXEL_PACK_BUFFER, geometry.width() * geometry.height() * 4, nullptr, GL_STREAM_READ);
+    GLRenderTarget::pushRenderTarget(&target);
+    glReadPixels(0, 0, geometry.width(), geometry.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    GLRenderTarget::popRenderTarget();
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    readback->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    m_readback.reset(readback);
+    m_readbackTimer.start();
+
+    // the fd is owned by the readback now
+    m_fd = -1;
+    m_scheduledGeometry = QRect();
+    m_multipleOutputsImage = QImage();
+    m_multipleOutputsRendered = QRegion();
+    m_captureCursor = false;
+    m_windowMode = WindowMode::NoCapture;
+}
+
+void ScreenShotEffect::checkReadback()
+{
+    if (!m_readback) {
+        m_readbackTimer.stop();
+        return;
+    }
+    effects->makeOpenGLContextCurrent();
+    const GLenum status = glClientWaitSync(m_readback->fence, GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return;
+    }
+    m_readbackTimer.stop();
+    QScopedPointer<ScreenShotReadback> readback(m_readback.take());
+    glDeleteSync(readback->fence);
+
+    QImage img(readback->size, QImage::Format_ARGB32);
+    bool valid = false;
+    if (status != GL_WAIT_FAILED) {
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, readback->buffer);
+        if (const void *data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, img.byteCount(), GL_MAP_READ_BIT)) {
+            memcpy(img.bits(), data, img.byteCount());
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+            valid = true;
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &readback->buffer);
+    if (!valid) {
+        qCDebug(KWINEFFECTS) << "Reading the screenshot failed";
+        close(readback->fd);
+        return;
+    }
+
+    QtConcurrent::run(
+        [] (int fd, QImage img, const QImage &cursor, const QPoint &cursorPos) {
+            ScreenShotEffect::convertFromGLImage(img, img.width(), img.height());
+            if (!cursor.isNull()) {
+                QPainter painter(&img);
+                painter.drawImage(cursorPos, cursor);
+            }
+            writeImage(fd, img);
+        }, readback->fd, img, readback->cursor, readback->cursorPos);
+}
+
+void ScreenShotEffect::cancelReadback()
+{
+    m_readbackTimer.stop();
+    if (!m_readback) {
+        return;
+    }
+    effects->makeOpenGLContextCurrent();
+    glDeleteSync(m_readback->fence);
+    glDeleteBuffers(1, &m_readback->buffer);
+    close(m_readback->fd);
+    m_readback.reset();
+}
+
 void ScreenShotEffect::sendReplyImage(const QImage &img)
 {
     if (m_fd != -1) {
-        QtConcurrent::run(
-            [] (int fd, const QImage &img) {
-                QFile file;
-                if (file.open(fd, QIODevice::WriteOnly, QFileDevice::AutoCloseHandle)) {
-                    QDataStream ds(&file);
-                    ds << img;
-                    file.close();
-                } else {
-                    close(fd);
-                }
-            }, m_fd, img);
+        QtConcurrent::run(writeImage, m_fd, img);
         m_fd = -1;
     } else {
         QDBusConnection::sessionBus().send(m_replyMessage.createReply(saveTempImage(img)));
@@ -543,7 +691,91 @@ QString ScreenShotEffect::screenshotArea(int x, int y, int width, int height, bo
     return QString();
 }
 
+QDBusUnixFileDescriptor ScreenShotEffect::streamScreen(int screen)
+{
+    if (!calledFromDBus()) {
+        return QDBusUnixFileDescriptor();
+    }
+    if (m_stream) {
+        sendErrorReply(s_errorAlreadyStreaming, s_errorAlreadyStreamingMsg);
+        return QDBusUnixFileDescriptor();
+    }
+    const QRect geometry = effects->clientArea(FullScreenArea, screen, 0);
+    if (geometry.isNull()) {
+        sendErrorReply(s_errorInvalidScreen, s_errorInvalidScreenMsg);
+        return QDBusUnixFileDescriptor();
+    }
+    QScopedPointer<ScreenShotStream> stream(new ScreenShotStream(geometry));
+    if (!stream->isValid()) {
+        sendErrorReply(s_errorStream, s_errorStreamMsg);
+        return QDBusUnixFileDescriptor();
+    }
+    m_stream.reset(stream.take());
+    m_streamWatcher->setWatchedServices(QStringList{message().service()});
+    // the first frame needs the complete screen
+    m_streamDamage = geometry;
+    effects->addRepaint(geometry);
+    return QDBusUnixFileDescriptor(m_stream->fd());
+}
+
+void ScreenShotEffect::stopStream()
+{
+    if (!calledFromDBus() || !m_streamWatcher->watchedServices().contains(message().service())) {
+        return;
+    }
+    destroyStream();
+}
+
+void ScreenShotEffect::resetStream()
+{
+    if (!m_stream) {
+        return;
+    }
+    destroyStream();
+    emit streamStopped();
+}
+
+void ScreenShotEffect::destroyStream()
+{
+    m_stream.reset();
+    m_streamDamage = QRegion();
+    m_streamWatcher->setWatchedServices(QStringList());
+}
+
+void ScreenShotEffect::captureStreamFrame()
+{
+    if (m_streamDamage.isEmpty()) {
+        return;
+    }
+    if (!m_cachedOutputGeometry.isNull() && !m_cachedOutputGeometry.contains(m_stream->geometry())) {
+        // rendered per output and this is not the streamed one
+        return;
+    }
+    const QRegion dirty = m_stream->beginFrame(m_streamDamage);
+    m_streamDamage = QRegion();
+    const QVector<QRect> rects = dirty.rects();
+    if (rects.count() > ScreenShotStream::MaxDamageRects) {
+        // fewer but larger reads are cheaper than many small ones
+        const QRect bounding = dirty.boundingRect();
+        m_stream->writeRect(bounding, grabFramebuffer(bounding));
+    } else {
+        for (const QRect &rect : rects) {
+            m_stream->writeRect(rect, grabFramebuffer(rect));
+        }
+    }
+    emit streamFrameAvailable(m_stream->commitFrame());
+}
+
 QImage ScreenShotEffect::blitScreenshot(const QRect &geometry)
+{
+    QImage img = grabFramebuffer(geometry);
+    if (m_captureCursor && !img.isNull()) {
+        grabPointerImage(img, geometry.x(), geometry.y());
+    }
+    return img;
+}
+
+QImage ScreenShotEffect::grabFramebuffer(const QRect &geometry)
 {
     QImage img;
     if (effects->isOpenGLCompositing())
@@ -577,10 +809,6 @@ QImage ScreenShotEffect::blitScreenshot(const QRect &geometry)
     }
 #endif
 
-    if (m_captureCursor) {
-        grabPointerImage(img, geometry.x(), geometry.y());
-    }
-
     return img;
 }
 
@@ -627,7 +855,7 @@ void ScreenShotEffect::convertFromGLImage(QImage &img, int w, int h)
 
 bool ScreenShotEffect::isActive() const
 {
-    return (m_scheduledScreenshot != NULL || !m_scheduledGeometry.isNull()) && !effects->isScreenLocked();
+    return (m_scheduledScreenshot != NULL || !m_scheduledGeometry.isNull() || m_stream) && !effects->isScreenLocked();
 }
 
 void ScreenShotEffect::windowClosed( EffectWindow* w )
@@ -649,6 +877,9 @@ bool ScreenShotEffect::isTakingScreenshot() const
     if (m_fd != -1) {
         return true;
     }
+    if (m_readback) {
+        return true;
+    }
     return false;
 }
 
@@ -25,13 +25,19 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QDBusContext>
 #include <QDBusConnection>
 #include <QDBusMessage>
+#include <QDBusServiceWatcher>
 #include <QDBusUnixFileDescriptor>
 #include <QObject>
 #include <QImage>
+#include <QScopedPointer>
+#include <QTimer>
 
 namespace KWin
 {
 
+struct ScreenShotReadback;
+class ScreenShotStream;
+
 class ScreenShotEffect : public Effect, protected QDBusContext
 {
     Q_OBJECT
@@ -44,6 +50,7 @@ public:
     ScreenShotEffect();
     virtual ~ScreenShotEffect();
     void paintScreen(int mask, QRegion region, ScreenPaintData &data) override;
+    void prePaintWindow(EffectWindow *w, WindowPrePaintData &data, int time) override;
     virtual void postPaintScreen();
     virtual bool isActive() const;
 
@@ -131,9 +138,37 @@ public Q_SLOTS:
      * @returns Path to stored screenshot, or null string in failure case.
      **/
     Q_SCRIPTABLE QString screenshotArea(int x, int y, int width, int height, bool captureCursor = false);
+    /**
+     * Starts to continuously capture the screen identified by @p screen into a ring of
+     * frames in shared memory. The layout of the memory is described by ScreenShotStream.
+     *
+     * A new frame is only captured if something changed on the screen, which gets announced
+     * through streamFrameAvailable. The stream ends when stopStream gets called, the calling
+     * DBus peer disconnects or the screen geometry changes. Unless ended by stopStream
+     * streamStopped gets emitted.
+     *
+     * Only one stream can exist at a time.
+     *
+     * @param screen Number of screen as numbered by QDesktopWidget
+     * @returns File descriptor of the shared memory
+     **/
+    Q_SCRIPTABLE QDBusUnixFileDescriptor streamScreen(int screen);
+    /**
+     * Ends the stream started by the calling DBus peer through streamScreen.
+     **/
+    Q_SCRIPTABLE void stopStream();
 
 Q_SIGNALS:
     Q_SCRIPTABLE void screenshotCreated(qulonglong handle);
+    /**
+     * Emitted when the frame with @p sequence got written into the stream.
+     **/
+    Q_SCRIPTABLE void streamFrameAvailable(qulonglong sequence);
+    /**
+     * Emitted when the stream ended without being stopped through stopStream, e.g. because
+     * the screen geometry changed. The shared memory does not receive further frames.
+     **/
+    Q_SCRIPTABLE void streamStopped();
 
 private Q_SLOTS:
     void windowClosed( KWin::EffectWindow* w );
@@ -141,6 +176,24 @@ private Q_SLOTS:
 private:
     void grabPointerImage(QImage& snapshot, int offsetx, int offsety);
     QImage blitScreenshot(const QRect &geometry);
+    QImage grabFramebuffer(const QRect &geometry);
+    void captureStreamFrame();
+    /**
+     * Ends the stream, announcing it through streamStopped.
+     **/
+    void resetStream();
+    void destroyStream();
+    /**
+     * Whether the framebuffer can be read asynchronously through a pixel buffer object.
+     **/
+    static bool supportsAsyncReadback();
+    /**
+     * Starts reading @p geometry of the framebuffer into a pixel buffer object. Once the
+     * GPU finished, the image gets converted and written into m_fd in a thread.
+     **/
+    void startReadback(const QRect &geometry);
+    void checkReadback();
+    void cancelReadback();
     QString saveTempImage(const QImage &img);
     void sendReplyImage(const QImage &img);
     enum class InfoMessageMode {
@@ -166,6 +219,11 @@ private:
     };
     WindowMode m_windowMode = WindowMode::NoCapture;
     int m_fd = -1;
+    QScopedPointer<ScreenShotReadback> m_readback;
+    QTimer m_readbackTimer;
+    QScopedPointer<ScreenShotStream> m_stream;
+    QRegion m_streamDamage;
+    QDBusServiceWatcher *m_streamWatcher;
 };
 
 } // namespace
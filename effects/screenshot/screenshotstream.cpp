@@ -0,0 +1,188 @@
+/********************************************************************
+ KWin - the KDE window manager
+ This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#include "screenshotstream.h"
+#include <config-kwin.h>
+
+#include <QFile>
+#include <QTemporaryFile>
+
+#include <atomic>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace KWin
+{
+
+static quint64 alignedSize(quint64 size)
+{
+    // keep every slot and the pixels on a cache line
+    return (size + 63) & ~quint64(63);
+}
+
+static int createSharedMemory(size_t size)
+{
+#if HAVE_MEMFD
+    int fd = memfd_create("kwin-screenshot-stream", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd != -1) {
+        if (ftruncate(fd, size) == 0) {
+            // the size is fixed for the lifetime of the stream, clients can rely on their mapping
+            fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL);
+            return fd;
+        }
+        close(fd);
+    }
+#endif
+    QTemporaryFile tmp;
+    if (!tmp.open()) {
+        return -1;
+    }
+    unlink(QFile::encodeName(tmp.fileName()).constData());
+    if (ftruncate(tmp.handle(), size) != 0) {
+        return -1;
+    }
+    return fcntl(tmp.handle(), F_DUPFD_CLOEXEC, 0);
+}
+
+ScreenShotStream::ScreenShotStream(const QRect &geometry)
+    : m_geometry(geometry)
+    , m_slotDamage(SlotCount, QRegion(0, 0, geometry.width(), geometry.height()))
+{
+    if (geometry.isEmpty()) {
+        return;
+    }
+    const quint64 stride = quint64(geometry.width()) * 4;
+    const quint64 pixelOffset = alignedSize(sizeof(FrameHeader));
+    const quint64 firstSlotOffset = alignedSize(sizeof(Header));
+    m_slotSize = alignedSize(pixelOffset + stride * geometry.height());
+    m_size = firstSlotOffset + m_slotSize * SlotCount;
+
+    m_fd = createSharedMemory(m_size);
+    if (m_fd == -1) {
+        return;
+    }
+    void *data = mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (data == MAP_FAILED) {
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+    m_data = static_cast<uchar*>(data);
+
+    Header *header = reinterpret_cast<Header*>(m_data);
+    header->magic = Magic;
+    header->version = Version;
+    header->width = geometry.width();
+    header->height = geometry.height();
+    header->stride = stride;
+    header->slotCount = SlotCount;
+    header->slotSize = m_slotSize;
+    header->firstSlotOffset = firstSlotOffset;
+    header->sequence = 0;
+    header->latestSlot = 0;
+    for (int i = 0; i < SlotCount; ++i) {
+        FrameHeader *frame = reinterpret_cast<FrameHeader*>(slot(i));
+        frame->sequence = 0;
+        frame->pixelOffset = pixelOffset;
+        frame->damageCount = 0;
+    }
+}
+
+ScreenShotStream::~ScreenShotStream()
+{
+    if (m_data) {
+        munmap(m_data, m_size);
+    }
+    if (m_fd != -1) {
+        close(m_fd);
+    }
+}
+
+bool ScreenShotStream::isValid() const
+{
+    return m_data != nullptr;
+}
+
+uchar *ScreenShotStream::slot(int index) const
+{
+    return m_data + reinterpret_cast<const Header*>(m_data)->firstSlotOffset + m_slotSize * index;
+}
+
+QRegion ScreenShotStream::beginFrame(const QRegion &damage)
+{
+    m_frameDamage = damage.translated(-m_geometry.topLeft()) & QRect(QPoint(0, 0), m_geometry.size());
+    for (QRegion &slotDamage : m_slotDamage) {
+        slotDamage |= m_frameDamage;
+    }
+    FrameHeader *frame = reinterpret_cast<FrameHeader*>(slot(m_currentSlot));
+    frame->sequence = 0;
+    std::atomic_thread_fence(std::memory_order_release);
+    return m_slotDamage.at(m_currentSlot).translated(m_geometry.topLeft());
+}
+
+void ScreenShotStream::writeRect(const QRect &rect, const QImage &image)
+{
+    const QRect source = rect.translated(-m_geometry.topLeft());
+    const QRect target = source & QRect(QPoint(0, 0), m_geometry.size());
+    if (target.isEmpty() || image.size() != rect.size()) {
+        return;
+    }
+    const QImage converted = image.convertToFormat(QImage::Format_ARGB32);
+    const Header *header = reinterpret_cast<const Header*>(m_data);
+    uchar *frame = slot(m_currentSlot);
+    uchar *pixels = frame + reinterpret_cast<const FrameHeader*>(frame)->pixelOffset;
+    const int offset = target.x() - source.x();
+    for (int y = target.top(); y <= target.bottom(); ++y) {
+        memcpy(pixels + y * header->stride + target.x() * 4,
+               converted.constScanLine(y - source.y()) + offset * 4,
+               target.width() * 4);
+    }
+}
+
+quint64 ScreenShotStream::commitFrame()
+{
+    FrameHeader *frame = reinterpret_cast<FrameHeader*>(slot(m_currentSlot));
+    const QVector<QRect> rects = m_frameDamage.rects();
+    if (rects.count() > MaxDamageRects) {
+        frame->damageCount = MaxDamageRects + 1;
+    } else {
+        frame->damageCount = rects.count();
+        for (int i = 0; i < rects.count(); ++i) {
+            const QRect &r = rects.at(i);
+            frame->damage[i] = {r.x(), r.y(), r.width(), r.height()};
+        }
+    }
+    m_slotDamage[m_currentSlot] = QRegion();
+    m_frameDamage = QRegion();
+
+    ++m_sequence;
+    std::atomic_thread_fence(std::memory_order_release);
+    frame->sequence = m_sequence;
+    Header *header = reinterpret_cast<Header*>(m_data);
+    header->latestSlot = m_currentSlot;
+    std::atomic_thread_fence(std::memory_order_release);
+    header->sequence = m_sequence;
+
+    m_currentSlot = (m_currentSlot + 1) % SlotCount;
+    return m_sequence;
+}
+
+}
@@ -0,0 +1,137 @@
+/********************************************************************
+ KWin - the KDE window manager
+ This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#ifndef KWIN_SCREENSHOTSTREAM_H
+#define KWIN_SCREENSHOTSTREAM_H
+
+#include <QImage>
+#include <QRect>
+#include <QRegion>
+#include <QVector>
+
+namespace KWin
+{
+
+/**
+ * @brief A ring of frames in shared memory which gets filled with an area of the screen.
+ *
+ * The memory starts with a Header, followed by Header::slotCount slots of Header::slotSize
+ * bytes at Header::firstSlotOffset. Each slot starts with a FrameHeader, followed by the
+ * pixels at FrameHeader::pixelOffset from the start of the slot. The pixels are 32 bit ARGB
+ * in native byte order, that is QImage::Format_ARGB32, with Header::stride bytes per line.
+ *
+ * A new frame is only written if something changed in the area. It goes into the slot after
+ * the previous one, whose FrameHeader::sequence is set to @c 0 while it is being written.
+ * Once complete Header::latestSlot and Header::sequence are updated. A reader should copy the
+ * slot and afterwards check that FrameHeader::sequence did not change in the meantime.
+ **/
+class ScreenShotStream
+{
+public:
+    enum {
+        Magic = 0x5353574b, // "KWSS"
+        Version = 1,
+        SlotCount = 3,
+        MaxDamageRects = 32
+    };
+    struct Rect {
+        qint32 x;
+        qint32 y;
+        qint32 width;
+        qint32 height;
+    };
+    struct Header {
+        quint32 magic;
+        quint32 version;
+        quint32 width;
+        quint32 height;
+        quint32 stride;
+        quint32 slotCount;
+        quint64 slotSize;
+        quint64 firstSlotOffset;
+        /**
+         * Sequence number of the latest complete frame, @c 0 as long as there is none.
+         **/
+        quint64 sequence;
+        quint32 latestSlot;
+        quint32 padding;
+    };
+    struct FrameHeader {
+        quint64 sequence;
+        quint64 pixelOffset;
+        /**
+         * Number of rects in damage which changed compared to the frame before, relative
+         * to the streamed area. If larger than MaxDamageRects the complete frame changed.
+         **/
+        quint32 damageCount;
+        quint32 padding;
+        Rect damage[MaxDamageRects];
+    };
+
+    explicit ScreenShotStream(const QRect &geometry);
+    ~ScreenShotStream();
+
+    bool isValid() const;
+    /**
+     * The file descriptor of the shared memory, owned by the stream.
+     **/
+    int fd() const {
+        return m_fd;
+    }
+    /**
+     * The streamed area in global coordinates.
+     **/
+    QRect geometry() const {
+        return m_geometry;
+    }
+
+    /**
+     * Starts a new frame in which @p damage changed.
+     * @returns The area which needs to be written, as the slot holds an older frame
+     **/
+    QRegion beginFrame(const QRegion &damage);
+    /**
+     * Writes @p image, which shows @p rect of the screen, into the current frame.
+     **/
+    void writeRect(const QRect &rect, const QImage &image);
+    /**
+     * Publishes the current frame.
+     * @returns The sequence number of the frame
+     **/
+    quint64 commitFrame();
+
+private:
+    uchar *slot(int index) const;
+    QRect m_geometry;
+    int m_fd = -1;
+    uchar *m_data = nullptr;
+    size_t m_size = 0;
+    quint64 m_slotSize = 0;
+    quint64 m_sequence = 0;
+    int m_currentSlot = 0;
+    QRegion m_frameDamage;
+    /**
+     * What changed since the respective slot was written the last time.
+     **/
+    QVector<QRegion> m_slotDamage;
+};
+
+}
+
+#endif
@@ -236,6 +236,15 @@ bool Workspace::workspaceEvent(xcb_generic_event_t *e)
             }
         }
     } else {
+        if (eventType == XCB_PROPERTY_NOTIFY) {
+            // drop the cached value before anyone, including the event filters, reads the new one
+            const auto *event = reinterpret_cast<xcb_property_notify_event_t*>(e);
+            if (Client *c = findClient(Predicate::WindowMatch, event->window)) {
+                c->invalidateProperty(event->atom);
+            } else if (Unmanaged *c = findUnmanaged(event->window)) {
+                c->invalidateProperty(event->atom);
+            }
+        }
         foreach (X11EventFilter *filter, m_eventFilters) {
             if (filter->eventTypes().contains(eventType) && filter->event(e)) {
                 return true;
@@ -242,17 +242,46 @@ bool processShortcut(Qt::KeyboardModifiers mods, T key, U &shortcuts)
     return true;
 }
 
-bool GlobalShortcutsManager::processKey(Qt::KeyboardModifiers mods, int keyQt)
+void GlobalShortcutsManager::setKGlobalAccelInterface(KGlobalAccelInterface *interface, const std::function<bool(int)> &keyPressed)
 {
     if (m_kglobalAccelInterface) {
+        disconnect(m_kglobalAccelInterface, &QObject::destroyed, this, nullptr);
+    }
+    m_kglobalAccelInterface = interface;
+    m_kglobalAccelKeyPressed = keyPressed;
+    if (!m_kglobalAccelInterface) {
+        // the grabs belong to the disabled plugin
+        m_kglobalAccelKeys.clear();
+        return;
+    }
+    connect(m_kglobalAccelInterface, &QObject::destroyed, this,
+        [this] {
+            m_kglobalAccelInterface = nullptr;
+            m_kglobalAccelKeyPressed = std::function<bool(int)>();
+            m_kglobalAccelKeys.clear();
+        }
+    );
+}
+
+void GlobalShortcutsManager::setKGlobalAccelKeyGrabbed(int keyQt, bool grabbed)
+{
+    if (grabbed) {
+        m_kglobalAccelKeys.insert(keyQt);
+    } else {
+        m_kglobalAccelKeys.remove(keyQt);
+    }
+}
+
+bool GlobalShortcutsManager::processKey(Qt::KeyboardModifiers mods, int keyQt)
+{
+    if (m_kglobalAccelInterface && m_kglobalAccelKeyPressed) {
         auto check = [this] (Qt::KeyboardModifiers mods, int keyQt) {
-            bool retVal = false;
-            QMetaObject::invokeMethod(m_kglobalAccelInterface,
-                                        "checkKeyPressed",
-                                        Qt::DirectConnection,
-                                        Q_RETURN_ARG(bool, retVal),
-                                        Q_ARG(int, int(mods) | keyQt));
-            return retVal;
+            const int key = int(mods) | keyQt;
+            // only keys grabbed by kglobalaccel can trigger one of its shortcuts
+            if (!m_kglobalAccelKeys.contains(key)) {
+                return false;
+            }
+            return m_kglobalAccelKeyPressed(key);
         };
         if (check(mods, keyQt)) {
             return true;
@@ -23,6 +23,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <kwinglobals.h>
 // Qt
 #include <QKeySequence>
+#include <QSet>
+
+#include <functional>
 
 class QAction;
 class KGlobalAccelD;
@@ -102,9 +105,23 @@ public:
     void processSwipeCancel();
     void processSwipeEnd();
 
-    void setKGlobalAccelInterface(KGlobalAccelInterface *interface) {
-        m_kglobalAccelInterface = interface;
-    }
+    /**
+     * @brief Sets the kglobalaccel platform interface.
+     *
+     * @param interface The kglobalaccel platform plugin, @c null if it got disabled
+     * @param keyPressed Function to pass a key press to kglobalaccel, returns whether it triggered
+     */
+    void setKGlobalAccelInterface(KGlobalAccelInterface *interface, const std::function<bool(int)> &keyPressed);
+    /**
+     * @brief Mirrors the keys grabbed by kglobalaccel.
+     *
+     * Only key presses for grabbed keys are passed to kglobalaccel, all other ones
+     * are rejected by a single lookup.
+     *
+     * @param keyQt The key combination including the modifiers
+     * @param grabbed Whether the key got grabbed or released
+     */
+    void setKGlobalAccelKeyGrabbed(int keyQt, bool grabbed);
 
 private:
     void objectDeleted(QObject *object);
@@ -113,6 +130,8 @@ private:
     QHash<Qt::KeyboardModifiers, QHash<SwipeDirection, GlobalShortcut*> > m_swipeShortcuts;
     KGlobalAccelD *m_kglobalAccel = nullptr;
     KGlobalAccelInterface *m_kglobalAccelInterface = nullptr;
+    std::function<bool(int)> m_kglobalAccelKeyPressed;
+    QSet<int> m_kglobalAccelKeys;
     GestureRecognizer *m_gestureRecognizer;
 };
 
@@ -62,7 +62,26 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace KWin
 {
 
-InputEventFilter::InputEventFilter() = default;
+InputEventFilter::InputEventFilter()
+    : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard | EventType::Touch | EventType::Gesture)
+{
+}
+
+InputEventFilter::InputEventFilter(EventTypes handledEvents)
+    : m_handledEvents(handledEvents)
+{
+}
+
+void InputEventFilter::setActive(bool active)
+{
+    if (m_active == active) {
+        return;
+    }
+    m_active = active;
+    if (input()) {
+        input()->updateFilterChains();
+    }
+}
 
 InputEventFilter::~InputEventFilter()
 {
@@ -188,6 +207,10 @@ void InputEventFilter::passToWaylandServer(QKeyEvent *event)
 #if HAVE_INPUT
 class VirtualTerminalFilter : public InputEventFilter {
 public:
+    VirtualTerminalFilter()
+        : InputEventFilter(EventType::Keyboard)
+    {
+    }
     bool keyEvent(QKeyEvent *event) override {
         // really on press and not on release? X11 switches on press.
         if (event->type() == QEvent::KeyPress && !event->isAutoRepeat()) {
@@ -204,6 +227,10 @@ public:
 
 class TerminateServerFilter : public InputEventFilter {
 public:
+    TerminateServerFilter()
+        : InputEventFilter(EventType::Keyboard)
+    {
+    }
     bool keyEvent(QKeyEvent *event) override {
         if (event->type() == QEvent::KeyPress && !event->isAutoRepeat()) {
             if (event->nativeVirtualKey() == XKB_KEY_Terminate_Server) {
@@ -218,6 +245,21 @@ public:
 
 class LockScreenFilter : public InputEventFilter {
 public:
+    LockScreenFilter()
+        : InputEventFilter()
+    {
+        if (waylandServer()->hasScreenLockerIntegration()) {
+            m_lockStateConnection = QObject::connect(ScreenLocker::KSldApp::self(), &ScreenLocker::KSldApp::lockStateChanged,
+                [this] {
+                    setActive(waylandServer()->isScreenLocked());
+                }
+            );
+        }
+        setActive(waylandServer()->isScreenLocked());
+    }
+    ~LockScreenFilter() {
+        QObject::disconnect(m_lockStateConnection);
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         if (!waylandServer()->isScreenLocked()) {
             return false;
@@ -394,12 +436,13 @@ private:
     bool touchSurfaceAllowed() const {
         return surfaceAllowed(&KWayland::Server::SeatInterface::focusedTouchSurface);
     }
+    QMetaObject::Connection m_lockStateConnection;
 };
 
 class PointerConstraintsFilter : public InputEventFilter {
 public:
     explicit PointerConstraintsFilter()
-        : InputEventFilter()
+        : InputEventFilter(EventType::Keyboard)
         , m_timer(new QTimer)
     {
         QObject::connect(m_timer.data(), &QTimer::timeout,
@@ -418,7 +461,7 @@ public:
     }
 
     bool keyEvent(QKeyEvent *event) override {
-        if (isActive()) {
+        if (isBreakingConstraints()) {
             if (event->type() == QEvent::KeyPress) {
                 // is that another key that gets pressed?
                 if (!event->isAutoRepeat() && event->key() != Qt::Key_Escape) {
@@ -447,14 +490,14 @@ public:
     }
 
     void cancel() {
-        if (!isActive()) {
+        if (!isBreakingConstraints()) {
             return;
         }
         m_timer->stop();
         input()->keyboard()->update();
     }
 
-    bool isActive() const {
+    bool isBreakingConstraints() const {
         return m_timer->isActive();
     }
 
@@ -465,6 +508,10 @@ private:
 
 class EffectsFilter : public InputEventFilter {
 public:
+    EffectsFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Keyboard | EventType::Touch)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         if (!effects) {
@@ -503,6 +550,10 @@ public:
 
 class MoveResizeFilter : public InputEventFilter {
 public:
+    MoveResizeFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         AbstractClient *c = workspace()->getMovingClient();
@@ -546,9 +597,15 @@ public:
 
 class WindowSelectorFilter : public InputEventFilter {
 public:
+    WindowSelectorFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard | EventType::Touch)
+    {
+        // only active while selecting
+        setActive(false);
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
-        if (!m_active) {
+        if (!isActive()) {
             return false;
         }
         switch (event->type()) {
@@ -569,11 +626,11 @@ public:
     bool wheelEvent(QWheelEvent *event) override {
         Q_UNUSED(event)
         // filter out while selecting a window
-        return m_active;
+        return isActive();
     }
     bool keyEvent(QKeyEvent *event) override {
         Q_UNUSED(event)
-        if (!m_active) {
+        if (!isActive()) {
             return false;
         }
         waylandServer()->seat()->setFocusedKeyboardSurface(nullptr);
@@ -651,26 +708,23 @@ public:
         return true;
     }
 
-    bool isActive() const {
-        return m_active;
-    }
     void start(std::function<void(KWin::Toplevel*)> callback) {
-        Q_ASSERT(!m_active);
-        m_active = true;
+        Q_ASSERT(!isActive());
+        setActive(true);
         m_callback = callback;
         input()->keyboard()->update();
         input()->cancelTouch();
     }
     void start(std::function<void(const QPoint &)> callback) {
-        Q_ASSERT(!m_active);
-        m_active = true;
+        Q_ASSERT(!isActive());
+        setActive(true);
         m_pointSelectionFallback = callback;
         input()->keyboard()->update();
         input()->cancelTouch();
     }
 private:
     void deactivate() {
-        m_active = false;
+        setActive(false);
         m_callback = std::function<void(KWin::Toplevel*)>();
         m_pointSelectionFallback = std::function<void(const QPoint &)>();
         input()->pointer()->removeWindowSelectionCursor();
@@ -699,7 +753,6 @@ private:
     void accept(const QPointF &pos) {
         accept(pos.toPoint());
     }
-    bool m_active = false;
     std::function<void(KWin::Toplevel*)> m_callback;
     std::function<void(const QPoint &)> m_pointSelectionFallback;
     QMap<quint32, QPointF> m_touchPoints;
@@ -707,6 +760,10 @@ private:
 
 class GlobalShortcutFilter : public InputEventFilter {
 public:
+    GlobalShortcutFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard | EventType::Gesture)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton);
         if (event->type() == QEvent::MouseButtonPress) {
@@ -761,6 +818,11 @@ public:
 };
 
 class InternalWindowEventFilter : public InputEventFilter {
+public:
+    InternalWindowEventFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard | EventType::Touch)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         auto internal = input()->pointer()->internalWindow();
@@ -922,6 +984,10 @@ private:
 
 class DecorationEventFilter : public InputEventFilter {
 public:
+    DecorationEventFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Touch)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         auto decoration = input()->pointer()->decoration();
@@ -1061,6 +1127,10 @@ private:
 class TabBoxInputFilter : public InputEventFilter
 {
 public:
+    TabBoxInputFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Keyboard)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 button) override {
         Q_UNUSED(button)
         if (!TabBox::TabBox::self() || !TabBox::TabBox::self()->isGrabbed()) {
@@ -1097,6 +1167,10 @@ public:
 class ScreenEdgeInputFilter : public InputEventFilter
 {
 public:
+    ScreenEdgeInputFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Touch)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         ScreenEdges::self()->isEntered(event);
@@ -1152,6 +1226,10 @@ private:
 class WindowActionInputFilter : public InputEventFilter
 {
 public:
+    WindowActionInputFilter()
+        : InputEventFilter(EventType::Pointer | EventType::Wheel | EventType::Touch)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         Q_UNUSED(nativeButton)
         if (event->type() != QEvent::MouseButtonPress) {
@@ -1403,6 +1481,10 @@ public:
 class DragAndDropInputFilter : public InputEventFilter
 {
 public:
+    DragAndDropInputFilter()
+        : InputEventFilter(EventType::Pointer)
+    {
+    }
     bool pointerEvent(QMouseEvent *event, quint32 nativeButton) override {
         auto seat = waylandServer()->seat();
         if (!seat->isDragPointer()) {
@@ -1490,17 +1572,40 @@ void InputRedirection::installInputEventFilter(InputEventFilter *filter)
 {
     Q_ASSERT(!m_filters.contains(filter));
     m_filters << filter;
+    updateFilterChains();
 }
 
 void InputRedirection::prependInputEventFilter(InputEventFilter *filter)
 {
     Q_ASSERT(!m_filters.contains(filter));
     m_filters.prepend(filter);
+    updateFilterChains();
 }
 
 void InputRedirection::uninstallInputEventFilter(InputEventFilter *filter)
 {
     m_filters.removeOne(filter);
+    updateFilterChains();
+}
+
+void InputRedirection::updateFilterChains()
+{
+    static const InputEventFilter::EventType types[] = {
+        InputEventFilter::EventType::Pointer,
+        InputEventFilter::EventType::Wheel,
+        InputEventFilter::EventType::Keyboard,
+        InputEventFilter::EventType::Touch,
+        InputEventFilter::EventType::Gesture
+    };
+    for (auto type : types) {
+        QVector<InputEventFilter*> &chain = m_filterChains[filterChainIndex(type)];
+        chain.clear();
+        for (InputEventFilter *filter : qAsConst(m_filters)) {
+            if (filter->isActive() && filter->handledEvents().testFlag(type)) {
+                chain << filter;
+            }
+        }
+    }
 }
 
 void InputRedirection::installInputEventSpy(InputEventSpy *spy)
@@ -1707,9 +1812,11 @@ void InputRedirection::setupLibInput()
         connect(conn, &LibInput::Connection::keyChanged, m_keyboard, &KeyboardInputRedirection::processKey);
         connect(conn, &LibInput::Connection::pointerMotion, this,
             [this] (const QSizeF &delta, const QSizeF &deltaNonAccel, uint32_t time, quint64 timeMicroseconds, LibInput::Device *device) {
-                m_pointer->processMotion(m_pointer->pos() + QPointF(delta.width(), delta.height()), delta, deltaNonAccel, time, timeMicroseconds, device);
+                m_pointer->processRelativeMotion(delta, deltaNonAccel, time, timeMicroseconds, device);
             }
         );
+        // the accumulated relative motion references the device
+        connect(conn, &LibInput::Connection::deviceRemoved, m_pointer, &PointerInputRedirection::flushPendingMotion);
         connect(conn, &LibInput::Connection::pointerMotionAbsolute, this,
             [this] (QPointF orig, QPointF screen, uint32_t time, LibInput::Device *device) {
                 Q_UNUSED(orig)
@@ -1978,9 +2085,14 @@ void InputRedirection::registerTouchpadSwipeShortcut(SwipeDirection direction, Q
     m_shortcuts->registerTouchpadSwipe(action, direction);
 }
 
-void InputRedirection::registerGlobalAccel(KGlobalAccelInterface *interface)
+void InputRedirection::registerGlobalAccel(KGlobalAccelInterface *interface, const std::function<bool(int)> &keyPressed)
+{
+    m_shortcuts->setKGlobalAccelInterface(interface, keyPressed);
+}
+
+void InputRedirection::registerGlobalAccelKey(int keyQt, bool grab)
 {
-    m_shortcuts->setKGlobalAccelInterface(interface);
+    m_shortcuts->setKGlobalAccelKeyGrabbed(keyQt, grab);
 }
 
 void InputRedirection::warpPointer(const QPointF &pos)
@@ -2025,7 +2137,7 @@ bool InputRedirection::isSelectingWindow() const
 
 bool InputRedirection::isBreakingPointerConstraints() const
 {
-    return m_pointerConstraintsFilter ? m_pointerConstraintsFilter->isActive() : false;
+    return m_pointerConstraintsFilter ? m_pointerConstraintsFilter->isBreakingConstraints() : false;
 }
 
 InputDeviceHandler::InputDeviceHandler(InputRedirection *input)
@@ -109,7 +109,18 @@ public:
     void registerPointerShortcut(Qt::KeyboardModifiers modifiers, Qt::MouseButton pointerButtons, QAction *action);
     void registerAxisShortcut(Qt::KeyboardModifiers modifiers, PointerAxisDirection axis, QAction *action);
     void registerTouchpadSwipeShortcut(SwipeDirection direction, QAction *action);
-    void registerGlobalAccel(KGlobalAccelInterface *interface);
+    /**
+     * @internal
+     * Registers the kglobalaccel platform plugin. The @p keyPressed function is invoked
+     * directly for key presses matching a key grabbed through registerGlobalAccelKey.
+     **/
+    void registerGlobalAccel(KGlobalAccelInterface *interface, const std::function<bool(int)> &keyPressed = std::function<bool(int)>());
+    /**
+     * @internal
+     * Mirrors a key grab of kglobalaccel, so that only key presses which can
+     * trigger a shortcut are passed to it.
+     **/
+    void registerGlobalAccelKey(int keyQt, bool grab);
 
     /**
      * @internal
@@ -170,9 +181,9 @@ public:
     }
 
     /**
-     * Sends an event through all InputFilters.
-     * The method @p function is invoked on each input filter. Processing is stopped if
-     * a filter returns @c true for @p function.
+     * Sends an event through the active InputFilters handling events of @p type.
+     * The method @p function is invoked on each of these input filters. Processing is
+     * stopped if a filter returns @c true for @p function.
      *
      * The UnaryPredicate is defined like the UnaryPredicate of std::any_of.
      * The signature of the function should be equivalent to the following:
@@ -184,8 +195,10 @@ public:
      * bind.
      **/
     template <class UnaryPredicate>
-    void processFilters(UnaryPredicate function) {
-        std::any_of(m_filters.constBegin(), m_filters.constEnd(), function);
+    void processFilters(InputEventFilter::EventType type, UnaryPredicate function) {
+        // copy, a filter might get (de)activated while processing the event
+        const QVector<InputEventFilter*> chain = m_filterChains[filterChainIndex(type)];
+        std::any_of(chain.constBegin(), chain.constEnd(), function);
     }
 
     /**
@@ -273,6 +286,22 @@ private:
     void reconfigure();
     void setupInputFilters();
     void installInputEventFilter(InputEventFilter *filter);
+    void updateFilterChains();
+    static int filterChainIndex(InputEventFilter::EventType type) {
+        switch (type) {
+        case InputEventFilter::EventType::Pointer:
+            return 0;
+        case InputEventFilter::EventType::Wheel:
+            return 1;
+        case InputEventFilter::EventType::Keyboard:
+            return 2;
+        case InputEventFilter::EventType::Touch:
+            return 3;
+        case InputEventFilter::EventType::Gesture:
+        default:
+            return 4;
+        }
+    }
     KeyboardInputRedirection *m_keyboard;
     PointerInputRedirection *m_pointer;
     TouchInputRedirection *m_touch;
@@ -285,10 +314,15 @@ private:
     PointerConstraintsFilter *m_pointerConstraintsFilter = nullptr;
 
     QVector<InputEventFilter*> m_filters;
+    /**
+     * The active filters in m_filters per InputEventFilter::EventType, see filterChainIndex.
+     **/
+    QVector<InputEventFilter*> m_filterChains[5];
     QVector<InputEventSpy*> m_spies;
 
     KWIN_SINGLETON(InputRedirection)
     friend InputRedirection *input();
+    friend class InputEventFilter;
     friend class DecorationEventFilter;
     friend class InternalWindowEventFilter;
     friend class ForwardInputFilter;
@@ -316,9 +350,54 @@ private:
 class KWIN_EXPORT InputEventFilter
 {
 public:
+    /**
+     * The classes of events a filter can handle.
+     **/
+    enum class EventType {
+        /**
+         * pointerEvent
+         **/
+        Pointer = 1 << 0,
+        /**
+         * wheelEvent
+         **/
+        Wheel = 1 << 1,
+        /**
+         * keyEvent
+         **/
+        Keyboard = 1 << 2,
+        /**
+         * touchDown, touchMotion and touchUp
+         **/
+        Touch = 1 << 3,
+        /**
+         * The pinch and swipe gesture events
+         **/
+        Gesture = 1 << 4
+    };
+    Q_DECLARE_FLAGS(EventTypes, EventType)
+
+    /**
+     * Creates a filter handling all types of events.
+     **/
     InputEventFilter();
+    /**
+     * Creates a filter which only gets passed events of the @p handledEvents types.
+     **/
+    explicit InputEventFilter(EventTypes handledEvents);
     virtual ~InputEventFilter();
 
+    EventTypes handledEvents() const {
+        return m_handledEvents;
+    }
+    /**
+     * Inactive filters are skipped when processing events.
+     * @see setActive
+     **/
+    bool isActive() const {
+        return m_active;
+    }
+
     /**
      * Event filter for pointer events which can be described by a QMouseEvent.
      *
@@ -362,6 +441,16 @@ public:
 
 protected:
     void passToWaylandServer(QKeyEvent *event);
+    /**
+     * Filters which only act in a certain mode, e.g. while the screen is locked,
+     * can deactivate themselves while not in that mode. The InputRedirection
+     * then does not need to invoke them at all. By default a filter is active.
+     **/
+    void setActive(bool active);
+
+private:
+    EventTypes m_handledEvents;
+    bool m_active = true;
 };
 
 class InputDeviceHandler : public QObject
@@ -415,6 +504,7 @@ void InputRedirection::registerShortcut(const QKeySequence &shortcut, QAction *a
 
 } // namespace KWin
 
+Q_DECLARE_OPERATORS_FOR_FLAGS(KWin::InputEventFilter::EventTypes)
 Q_DECLARE_METATYPE(KWin::InputRedirection::KeyboardKeyState)
 Q_DECLARE_METATYPE(KWin::InputRedirection::PointerButtonState)
 Q_DECLARE_METATYPE(KWin::InputRedirection::PointerAxis)
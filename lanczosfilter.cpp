@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "screens.h"
 #include "unmanaged.h"
 #include "options.h"
+#include "texturememorymanager.h"
 #include "workspace.h"
 
 #include <kwinglutils.h>
@@ -41,6 +42,34 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 namespace KWin
 {
 
+/**
+ * The cached result of the filter, accounted with the TextureMemoryManager
+ * and evicted when the texture memory exceeds the budget.
+ **/
+class LanczosCacheTexture : public GLTexture
+{
+public:
+    LanczosCacheTexture(EffectWindowImpl *w, int width, int height)
+        : GLTexture(GL_RGBA8, width, height)
+        , m_textureMemory(TextureMemoryManager::Owner::LanczosCache, w->window())
+    {
+        m_textureMemory.setSize(QSize(width, height));
+        m_textureMemory.setEvictCallback([w] {
+            // the window owns the cache texture, so it is still around
+            effects->makeOpenGLContextCurrent();
+            delete static_cast<GLTexture*>(w->data(LanczosCacheRole).value<void*>());
+            w->setData(LanczosCacheRole, QVariant());
+        });
+    }
+
+    void markUsed() {
+        m_textureMemory.markUsed();
+    }
+
+private:
+    TextureMemoryEntry m_textureMemory;
+};
+
 LanczosFilter::LanczosFilter(QObject* parent)
     : QObject(parent)
     , m_offscreenTex(0)
@@ -204,9 +233,10 @@ void LanczosFilter::performPaint(EffectWindowImpl* w, int mask, QRegion region,
             int sw = width;
             int sh = height;
 
-            GLTexture *cachedTexture = static_cast< GLTexture*>(w->data(LanczosCacheRole).value<void*>());
+            LanczosCacheTexture *cachedTexture = static_cast< LanczosCacheTexture*>(w->data(LanczosCacheRole).value<void*>());
             if (cachedTexture) {
                 if (cachedTexture->width() == tw && cachedTexture->height() == th) {
+                    cachedTexture->markUsed();
                     cachedTexture->bind();
                     if (hardwareClipping) {
                         glEnable(GL_SCISSOR_TEST);
@@ -338,7 +368,7 @@ void LanczosFilter::performPaint(EffectWindowImpl* w, int mask, QRegion region,
             ShaderManager::instance()->popShader();
 
             // create cache texture
-            GLTexture *cache = new GLTexture(GL_RGBA8, tw, th);
+            GLTexture *cache = new LanczosCacheTexture(w, tw, th);
 
             cache->setFilter(GL_LINEAR);
             cache->setWrapMode(GL_CLAMP_TO_EDGE);
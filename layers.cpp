@@ -97,6 +97,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QDebug>
 
+#include <algorithm>
+
 namespace KWin
 {
 
@@ -473,21 +475,32 @@ void Workspace::restoreSessionStackingOrder(Client* c)
 {
     if (c->sessionStackingOrder() < 0)
         return;
-    StackingUpdatesBlocker blocker(this);
-    unconstrained_stacking_order.removeAll(c);
-    for (ToplevelList::Iterator it = unconstrained_stacking_order.begin();  // from bottom
-            it != unconstrained_stacking_order.end();
-            ++it) {
-        Client *current = qobject_cast<Client*>(*it);
-        if (!current) {
+    // A session restore maps many clients in a row. Their session positions get
+    // applied together once the current event loop iteration is done.
+    if (m_pendingSessionStacking.isEmpty()) {
+        QTimer::singleShot(0, this, &Workspace::applySessionStackingOrder);
+    }
+    m_pendingSessionStacking << c;
+}
+
+void Workspace::applySessionStackingOrder()
+{
+    const QVector<QPointer<Client>> pending = m_pendingSessionStacking;
+    m_pendingSessionStacking.clear();
+    for (Client *c : pending) {
+        if (!c || !clients.contains(c)) {
             continue;
         }
-        if (current->sessionStackingOrder() > c->sessionStackingOrder()) {
-            unconstrained_stacking_order.insert(it, c);
-            return;
-        }
+        unconstrained_stacking_order.removeAll(c);
+        auto it = std::find_if(unconstrained_stacking_order.begin(), unconstrained_stacking_order.end(), // from bottom
+            [c] (Toplevel *t) {
+                Client *current = qobject_cast<Client*>(t);
+                return current && current->sessionStackingOrder() > c->sessionStackingOrder();
+            }
+        );
+        unconstrained_stacking_order.insert(it, c);
     }
-    unconstrained_stacking_order.append(c);
+    updateStackingOrder();
 }
 
 /*!
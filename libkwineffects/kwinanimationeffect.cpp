@@ -36,14 +36,17 @@ namespace KWin {
 
 QElapsedTimer AnimationEffect::s_clock;
 
+typedef QMap< EffectWindow*, QPair<QVector<AniData>, QRect> > AnimationMap;
+
 class AnimationEffectPrivate {
 public:
     AnimationEffectPrivate()
     {
-        m_animated = m_damageDirty = m_animationsTouched = m_isInitialized = false;
+        m_animated = m_damageDirty = m_needSceneRepaint = m_animationsTouched = m_isInitialized = false;
         m_justEndedAnimation = 0;
     }
-    AnimationEffect::AniMap m_animations;
+    AnimationMap m_animations;
+    QHash<quint64, EffectWindow*> m_animationIndex; // animation id -> animated window
     EffectWindowList m_zombies;
     bool m_animated, m_damageDirty, m_needSceneRepaint, m_animationsTouched, m_isInitialized;
     quint64 m_justEndedAnimation; // protect against cancel
@@ -234,13 +237,14 @@ quint64 AnimationEffect::p_animate( EffectWindow *w, Attribute a, uint meta, int
         connect (effects,   SIGNAL(windowPaddingChanged(KWin::EffectWindow*,QRect)),
                             SLOT(_expandedGeometryChanged(KWin::EffectWindow*,QRect)));
     }
-    AniMap::iterator it = d->m_animations.find(w);
+    AnimationMap::iterator it = d->m_animations.find(w);
     if (it == d->m_animations.end())
-        it = d->m_animations.insert(w, QPair<QList<AniData>, QRect>(QList<AniData>(), QRect()));
+        it = d->m_animations.insert(w, QPair<QVector<AniData>, QRect>(QVector<AniData>(), QRect()));
     it->first.append(AniData(a, meta, ms, to, curve, delay, from, waitAtSource, keepAtTarget));
     quint64 ret_id = ++d->m_animCounter;
     it->first.last().id = ret_id;
     it->second = QRect();
+    d->m_animationIndex.insert(ret_id, w);
 
     d->m_animationsTouched = true;
 
@@ -251,7 +255,12 @@ quint64 AnimationEffect::p_animate( EffectWindow *w, Attribute a, uint meta, int
             w->addLayerRepaint(0, 0, s.width(), s.height());
     }
     else {
-        triggerRepaint();
+        // only the layer rect of this window got invalidated, no need to recompute all of them
+        updateLayerRepaints();
+        if (d->m_needSceneRepaint)
+            effects->addRepaintFull();
+        else
+            w->addLayerRepaint(it->second);
     }
     return ret_id;
 }
@@ -261,17 +270,19 @@ bool AnimationEffect::retarget(quint64 animationId, FPx2 newTarget, int newRemai
     Q_D(AnimationEffect);
     if (animationId == d->m_justEndedAnimation)
         return false; // this is just ending, do not try to retarget it
-    for (AniMap::iterator entry = d->m_animations.begin(),
-                         mapEnd = d->m_animations.end(); entry != mapEnd; ++entry) {
-        for (QList<AniData>::iterator anim = entry->first.begin(),
-                                   animEnd = entry->first.end(); anim != animEnd; ++anim) {
-            if (anim->id == animationId) {
-                anim->from.set(interpolated(*anim, 0), interpolated(*anim, 1));
-                validate(anim->attribute, anim->meta, nullptr, &newTarget, entry.key());
-                anim->to.set(newTarget[0], newTarget[1]);
-                anim->duration = anim->time + newRemainingTime;
-                return true;
-            }
+    AnimationMap::iterator entry = d->m_animations.find(d->m_animationIndex.value(animationId));
+    if (entry == d->m_animations.end())
+        return false; // no animation found
+    for (QVector<AniData>::iterator anim = entry->first.begin(),
+                                 animEnd = entry->first.end(); anim != animEnd; ++anim) {
+        if (anim->id == animationId) {
+            anim->from.set(interpolated(*anim, 0), interpolated(*anim, 1));
+            validate(anim->attribute, anim->meta, nullptr, &newTarget, entry.key());
+            anim->to.set(newTarget[0], newTarget[1]);
+            anim->duration = anim->time + newRemainingTime;
+            entry->second = QRect(); // the covered area changes with the target
+            d->m_damageDirty = true;
+            return true;
         }
     }
     return false; // no animation found
@@ -282,23 +293,25 @@ bool AnimationEffect::cancel(quint64 animationId)
     Q_D(AnimationEffect);
     if (animationId == d->m_justEndedAnimation)
         return true; // this is just ending, do not try to cancel it but fake success
-    for (AniMap::iterator entry = d->m_animations.begin(), mapEnd = d->m_animations.end(); entry != mapEnd; ++entry) {
-        for (QList<AniData>::iterator anim = entry->first.begin(), animEnd = entry->first.end(); anim != animEnd; ++anim) {
-            if (anim->id == animationId) {
-                entry->first.erase(anim); // remove the animation
-                if (entry->first.isEmpty()) { // no other animations on the window, release it.
-                    const int i = d->m_zombies.indexOf(entry.key());
-                    if ( i > -1 ) {
-                        d->m_zombies.removeAt( i );
-                        entry.key()->unrefWindow();
-                    }
-                    d->m_animations.erase(entry);
+    AnimationMap::iterator entry = d->m_animations.find(d->m_animationIndex.value(animationId));
+    if (entry == d->m_animations.end())
+        return false;
+    for (QVector<AniData>::iterator anim = entry->first.begin(), animEnd = entry->first.end(); anim != animEnd; ++anim) {
+        if (anim->id == animationId) {
+            entry->first.erase(anim); // remove the animation
+            d->m_animationIndex.remove(animationId);
+            if (entry->first.isEmpty()) { // no other animations on the window, release it.
+                const int i = d->m_zombies.indexOf(entry.key());
+                if ( i > -1 ) {
+                    d->m_zombies.removeAt( i );
+                    entry.key()->unrefWindow();
                 }
-                if (d->m_animations.isEmpty())
-                    disconnectGeometryChanges();
-                d->m_animationsTouched = true; // could be called from animationEnded
-                return true;
+                d->m_animations.erase(entry);
             }
+            if (d->m_animations.isEmpty())
+                disconnectGeometryChanges();
+            d->m_animationsTouched = true; // could be called from animationEnded
+            return true;
         }
     }
     return false;
@@ -313,12 +326,12 @@ void AnimationEffect::prePaintScreen( ScreenPrePaintData& data, int time )
     }
 
     d->m_animationsTouched = false;
-    AniMap::iterator entry = d->m_animations.begin(), mapEnd = d->m_animations.end();
+    AnimationMap::iterator entry = d->m_animations.begin(), mapEnd = d->m_animations.end();
     d->m_animated = false;
 //     short int transformed = 0;
     while (entry != mapEnd) {
         bool invalidateLayerRect = false;
-        QList<AniData>::iterator anim = entry->first.begin(), animEnd = entry->first.end();
+        QVector<AniData>::iterator anim = entry->first.begin(), animEnd = entry->first.end();
         int animCounter = 0;
         while (anim != animEnd) {
             if (anim->startTime > clock()) {
@@ -352,15 +365,12 @@ void AnimationEffect::prePaintScreen( ScreenPrePaintData& data, int time )
                 // so we've to restore the former states, ie. find our window list and animation
                 if (d->m_animationsTouched) {
                     d->m_animationsTouched = false;
-                    entry = d->m_animations.begin(), mapEnd = d->m_animations.end();
-                    while (entry.key() != oldW && entry != mapEnd)
-                        ++entry;
+                    entry = d->m_animations.find(oldW), mapEnd = d->m_animations.end();
                     Q_ASSERT(entry != mapEnd); // usercode should not delete animations from animationEnded (not even possible atm.)
-                    anim = entry->first.begin(), animEnd = entry->first.end();
                     Q_ASSERT(animCounter < entry->first.count());
-                    for (int i = 0; i < animCounter; ++i)
-                        ++anim;
+                    anim = entry->first.begin() + animCounter;
                 }
+                d->m_animationIndex.remove(anim->id);
                 anim = entry->first.erase(anim);
                 invalidateLayerRect = d->m_damageDirty = true;
                 animEnd = entry->first.end();
@@ -391,6 +401,7 @@ void AnimationEffect::prePaintScreen( ScreenPrePaintData& data, int time )
                 w->unrefWindow();
             d->m_zombies.clear();
         }
+        d->m_animationIndex.clear();
     }
 
     effects->prePaintScreen(data, time);
@@ -493,10 +504,10 @@ void AnimationEffect::prePaintWindow( EffectWindow* w, WindowPrePaintData& data,
 {
     Q_D(AnimationEffect);
     if ( d->m_animated ) {
-        AniMap::const_iterator entry = d->m_animations.constFind( w );
+        AnimationMap::const_iterator entry = d->m_animations.constFind( w );
         if ( entry != d->m_animations.constEnd() ) {
             bool isUsed = false;
-            for (QList<AniData>::const_iterator anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim) {
+            for (QVector<AniData>::const_iterator anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim) {
                 if (anim->startTime > clock() && !anim->waitAtSource)
                     continue;
 
@@ -538,9 +549,9 @@ void AnimationEffect::paintWindow( EffectWindow* w, int mask, QRegion region, Wi
 {
     Q_D(AnimationEffect);
     if ( d->m_animated ) {
-        AniMap::const_iterator entry = d->m_animations.constFind( w );
+        AnimationMap::const_iterator entry = d->m_animations.constFind( w );
         if ( entry != d->m_animations.constEnd() ) {
-            for ( QList<AniData>::const_iterator anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim ) {
+            for ( QVector<AniData>::const_iterator anim = entry->first.constBegin(); anim != entry->first.constEnd(); ++anim ) {
 
                 if (anim->startTime > clock() && !anim->waitAtSource)
                     continue;
@@ -653,10 +664,10 @@ void AnimationEffect::postPaintScreen()
         if (d->m_needSceneRepaint) {
             effects->addRepaintFull();
         } else {
-            AniMap::const_iterator it = d->m_animations.constBegin(), end = d->m_animations.constEnd();
+            AnimationMap::const_iterator it = d->m_animations.constBegin(), end = d->m_animations.constEnd();
             for (; it != end; ++it) {
                 bool addRepaint = false;
-                QList<AniData>::const_iterator anim = it->first.constBegin();
+                QVector<AniData>::const_iterator anim = it->first.constBegin();
                 for (; anim != it->first.constEnd(); ++anim) {
                     if (anim->startTime > clock())
                         continue;
@@ -756,13 +767,13 @@ void AnimationEffect::setMetaData( MetaType type, uint value, uint &meta )
 void AnimationEffect::triggerRepaint()
 {
     Q_D(AnimationEffect);
-    for (AniMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd(); entry != mapEnd; ++entry)
+    for (AnimationMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd(); entry != mapEnd; ++entry)
         *const_cast<QRect*>(&(entry->second)) = QRect();
     updateLayerRepaints();
     if (d->m_needSceneRepaint) {
         effects->addRepaintFull();
     } else {
-        AniMap::const_iterator it = d->m_animations.constBegin(), end = d->m_animations.constEnd();
+        AnimationMap::const_iterator it = d->m_animations.constBegin(), end = d->m_animations.constEnd();
         for (; it != end; ++it) {
             it.key()->addLayerRepaint(it->second);
         }
@@ -791,7 +802,15 @@ void AnimationEffect::updateLayerRepaints()
 {
     Q_D(AnimationEffect);
     d->m_needSceneRepaint = false;
-    for (AniMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd(); entry != mapEnd; ++entry) {
+    for (AnimationMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd(); entry != mapEnd; ++entry) {
+        // only the invalidated layer rects get recomputed, but the scene repaint
+        // depends on all running animations
+        for (QVector<AniData>::const_iterator anim = entry->first.constBegin(), animEnd = entry->first.constEnd(); anim != animEnd; ++anim) {
+            if (anim->attribute == Generic && anim->startTime <= clock()) {
+                d->m_needSceneRepaint = true; // we don't know whether this will change visual stacking order
+                break;
+            }
+        }
         if (!entry->second.isNull())
             continue;
         float f[2] = {1.0, 1.0};
@@ -799,7 +818,7 @@ void AnimationEffect::updateLayerRepaints()
         bool createRegion = false;
         QList<QRect> rects;
         QRect *layerRect = const_cast<QRect*>(&(entry->second));
-        for (QList<AniData>::const_iterator anim = entry->first.constBegin(), animEnd = entry->first.constEnd(); anim != animEnd; ++anim) {
+        for (QVector<AniData>::const_iterator anim = entry->first.constBegin(), animEnd = entry->first.constEnd(); anim != animEnd; ++anim) {
             if (anim->startTime > clock())
                 continue;
             switch (anim->attribute) {
@@ -814,8 +833,9 @@ void AnimationEffect::updateLayerRepaints()
                     *layerRect = QRect(QPoint(0, 0), effects->virtualScreenSize());
                     goto region_creation; // sic! no need to do anything else
                 case Generic:
-                    d->m_needSceneRepaint = true; // we don't know whether this will change visual stacking order
-                    return; // sic! no need to do anything else
+                    // the scene gets repainted, the layer rect stays invalid
+                    createRegion = false;
+                    goto region_creation; // sic! no need to do anything else
                 case Translation:
                 case Position: {
                     createRegion = true;
@@ -901,7 +921,7 @@ void AnimationEffect::_expandedGeometryChanged(KWin::EffectWindow *w, const QRec
 {
     Q_UNUSED(old)
     Q_D(AnimationEffect);
-    AniMap::const_iterator entry = d->m_animations.constFind(w);
+    AnimationMap::const_iterator entry = d->m_animations.constFind(w);
     if (entry != d->m_animations.constEnd()) {
         *const_cast<QRect*>(&(entry->second)) = QRect();
         updateLayerRepaints();
@@ -923,7 +943,12 @@ void AnimationEffect::_windowDeleted( EffectWindow* w )
 {
     Q_D(AnimationEffect);
     d->m_zombies.removeAll( w ); // TODO this line is a workaround for a bug in KWin 4.8.0 & 4.8.1
-    d->m_animations.remove( w );
+    AnimationMap::iterator entry = d->m_animations.find(w);
+    if (entry != d->m_animations.end()) {
+        for (const AniData &anim : qAsConst(entry->first))
+            d->m_animationIndex.remove(anim.id);
+        d->m_animations.erase(entry);
+    }
 }
 
 
@@ -934,13 +959,13 @@ QString AnimationEffect::debug(const QString &/*parameter*/) const
     if (d->m_animations.isEmpty())
         dbg = QStringLiteral("No window is animated");
     else {
-        AniMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd();
+        AnimationMap::const_iterator entry = d->m_animations.constBegin(), mapEnd = d->m_animations.constEnd();
         for (; entry != mapEnd; ++entry) {
             QString caption = entry.key()->isDeleted() ? QStringLiteral("[Deleted]") : entry.key()->caption();
             if (caption.isEmpty())
                 caption = QStringLiteral("[Untitled]");
             dbg += QLatin1String("Animating window: ") + caption + QLatin1Char('\n');
-            QList<AniData>::const_iterator anim = entry->first.constBegin(), animEnd = entry->first.constEnd();
+            QVector<AniData>::const_iterator anim = entry->first.constBegin(), animEnd = entry->first.constEnd();
             for (; anim != animEnd; ++anim)
                 dbg += anim->debugInfo();
         }
@@ -32,7 +32,12 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPixmap>
 #include <QImage>
 #include <QHash>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
 #include <QFile>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QVector2D>
 #include <QVector3D>
 #include <QVector4D>
@@ -309,6 +314,36 @@ bool GLShader::load(const QByteArray &vertexSource, const QByteArray &fragmentSo
     return link();
 }
 
+bool GLShader::loadProgramBinary(GLenum format, const QByteArray &binary)
+{
+    glProgramBinary(mProgram, format, binary.constData(), binary.size());
+
+    // a binary of an outdated driver is rejected without an error
+    int status;
+    glGetProgramiv(mProgram, GL_LINK_STATUS, &status);
+    mValid = status != 0;
+    return mValid;
+}
+
+QByteArray GLShader::programBinary(GLenum *format) const
+{
+    GLint length = 0;
+    glGetProgramiv(mProgram, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0) {
+        return QByteArray();
+    }
+    QByteArray binary(length, 0);
+    GLsizei written = 0;
+    glGetProgramBinary(mProgram, length, &written, format, binary.data());
+    binary.resize(written);
+    return binary;
+}
+
+void GLShader::setProgramBinaryRetrievable()
+{
+    glProgramParameteri(mProgram, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+}
+
 void GLShader::bindAttributeLocation(const char *name, int index)
 {
     glBindAttribLocation(mProgram, index, name);
@@ -566,6 +601,30 @@ ShaderManager::ShaderManager()
     } else {
         m_resourcePath = QStringLiteral(":/effect-shaders-1.10/");
     }
+
+    const bool programBinarySupported = GLPlatform::instance()->isGLES() ? hasGLVersion(3, 0) :
+        (hasGLVersion(4, 1) || hasGLExtension(QByteArrayLiteral("GL_ARB_get_program_binary")));
+    if (programBinarySupported) {
+        GLint count = 0;
+        glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &count);
+        if (count > 0) {
+            m_programBinaryFormats.resize(count);
+            glGetIntegerv(GL_PROGRAM_BINARY_FORMATS, m_programBinaryFormats.data());
+        }
+    }
+    if (!m_programBinaryFormats.isEmpty()) {
+        // binaries are only valid for the driver which created them
+        QCryptographicHash driver(QCryptographicHash::Sha1);
+        driver.addData(GLPlatform::instance()->glVendorString());
+        driver.addData(GLPlatform::instance()->glRendererString());
+        driver.addData(GLPlatform::instance()->glVersionString());
+        driver.addData(GLPlatform::instance()->glShadingLanguageVersionString());
+        const QString path = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) +
+                             QStringLiteral("/kwin/glsl/") + QString::fromLatin1(driver.result().toHex());
+        if (QDir().mkpath(path)) {
+            m_programBinaryPath = path + QLatin1Char('/');
+        }
+    }
 }
 
 ShaderManager::~ShaderManager()
@@ -909,6 +968,20 @@ GLShader *ShaderManager::generateShader(ShaderTraits traits)
     return generateCustomShader(traits);
 }
 
+void ShaderManager::precompileShaders()
+{
+    const ShaderTraits traits[] = {
+        ShaderTrait::MapTexture,
+        ShaderTrait::MapTexture | ShaderTrait::Modulate,
+        ShaderTrait::MapTexture | ShaderTrait::AdjustSaturation,
+        ShaderTrait::MapTexture | ShaderTrait::Modulate | ShaderTrait::AdjustSaturation,
+        ShaderTrait::UniformColor
+    };
+    for (ShaderTraits t : traits) {
+        shader(t);
+    }
+}
+
 GLShader *ShaderManager::generateCustomShader(ShaderTraits traits, const QByteArray &vertexSource, const QByteArray &fragmentSource)
 {
     const QByteArray vertex   = vertexSource.isEmpty() ? generateVertexSource(traits) : vertexSource;
@@ -922,15 +995,7 @@ GLShader *ShaderManager::generateCustomShader(ShaderTraits traits, const QByteAr
     qCDebug(LIBKWINGLUTILS) << "**************";
 #endif
 
-    GLShader *shader = new GLShader(GLShader::ExplicitLinking);
-    shader->load(vertex, fragment);
-
-    shader->bindAttributeLocation("position", VA_Position);
-    shader->bindAttributeLocation("texcoord", VA_TexCoord);
-    shader->bindFragDataLocation("fragColor", 0);
-
-    shader->link();
-    return shader;
+    return linkShader(vertex, fragment, true);
 }
 
 GLShader *ShaderManager::generateShaderFromResources(ShaderTraits traits, const QString &vertexFile, const QString &fragmentFile)
@@ -1036,14 +1101,94 @@ void ShaderManager::bindAttributeLocations(GLShader *shader) const
 
 GLShader *ShaderManager::loadShaderFromCode(const QByteArray &vertexSource, const QByteArray &fragmentSource)
 {
+    return linkShader(vertexSource, fragmentSource, false);
+}
+
+GLShader *ShaderManager::linkShader(const QByteArray &vertexSource, const QByteArray &fragmentSource, bool traitLocations)
+{
+    const QByteArray key = programBinaryKey(vertexSource, fragmentSource, traitLocations);
+    if (!key.isEmpty()) {
+        GLShader *shader = new GLShader(GLShader::ExplicitLinking);
+        if (loadProgramBinary(shader, key)) {
+            return shader;
+        }
+        delete shader;
+    }
+
     GLShader *shader = new GLShader(GLShader::ExplicitLinking);
     shader->load(vertexSource, fragmentSource);
-    bindAttributeLocations(shader);
+
+    if (traitLocations) {
+        shader->bindAttributeLocation("position", VA_Position);
+        shader->bindAttributeLocation("texcoord", VA_TexCoord);
+    } else {
+        bindAttributeLocations(shader);
+    }
     bindFragDataLocations(shader);
-    shader->link();
+
+    if (!key.isEmpty()) {
+        shader->setProgramBinaryRetrievable();
+    }
+    if (shader->link() && !key.isEmpty()) {
+        storeProgramBinary(shader, key);
+    }
     return shader;
 }
 
+QByteArray ShaderManager::programBinaryKey(const QByteArray &vertexSource, const QByteArray &fragmentSource, bool traitLocations) const
+{
+    if (m_programBinaryPath.isEmpty()) {
+        return QByteArray();
+    }
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(m_debug ? QByteArrayLiteral("debug:") : QByteArrayLiteral("release:"));
+    hash.addData(traitLocations ? QByteArrayLiteral("traits:") : QByteArrayLiteral("code:"));
+    hash.addData(vertexSource);
+    // separate the sources, so that moving code between them changes the key
+    hash.addData("\0", 1);
+    hash.addData(fragmentSource);
+    return hash.result().toHex();
+}
+
+bool ShaderManager::loadProgramBinary(GLShader *shader, const QByteArray &key) const
+{
+    QFile file(m_programBinaryPath + QString::fromLatin1(key));
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    QDataStream stream(&file);
+    quint32 format = 0;
+    QByteArray binary;
+    stream >> format >> binary;
+    if (stream.status() != QDataStream::Ok || binary.isEmpty() ||
+            !m_programBinaryFormats.contains(GLint(format))) {
+        file.remove();
+        return false;
+    }
+    if (!shader->loadProgramBinary(format, binary)) {
+        qCDebug(LIBKWINGLUTILS) << "Discarding outdated program binary" << key;
+        file.remove();
+        return false;
+    }
+    return true;
+}
+
+void ShaderManager::storeProgramBinary(GLShader *shader, const QByteArray &key) const
+{
+    GLenum format = 0;
+    const QByteArray binary = shader->programBinary(&format);
+    if (binary.isEmpty()) {
+        return;
+    }
+    QSaveFile file(m_programBinaryPath + QString::fromLatin1(key));
+    if (!file.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QDataStream stream(&file);
+    stream << quint32(format) << binary;
+    file.commit();
+}
+
 /***  GLRenderTarget  ***/
 bool GLRenderTarget::sSupported = false;
 bool GLRenderTarget::s_blitSupported = false;
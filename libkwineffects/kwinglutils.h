@@ -161,6 +161,12 @@ protected:
     bool load(const QByteArray &vertexSource, const QByteArray &fragmentSource);
     const QByteArray prepareSource(GLenum shaderType, const QByteArray &sourceCode) const;
     bool compile(GLuint program, GLenum shaderType, const QByteArray &sourceCode) const;
+    /**
+     * Loads the linked program from @p binary in @p format, as returned by programBinary.
+     **/
+    bool loadProgramBinary(GLenum format, const QByteArray &binary);
+    QByteArray programBinary(GLenum *format) const;
+    void setProgramBinaryRetrievable();
     void bind();
     void unbind();
     void resolveLocations();
@@ -307,6 +313,13 @@ public:
      */
     bool selfTest();
 
+    /**
+     * Creates the shaders for the trait combinations the compositor uses all the time,
+     * so that they do not get compiled while painting the first frames which need them.
+     * @since 5.12
+     **/
+    void precompileShaders();
+
     /**
      * @return a pointer to the ShaderManager instance
      **/
@@ -327,11 +340,24 @@ private:
     QByteArray generateVertexSource(ShaderTraits traits) const;
     QByteArray generateFragmentSource(ShaderTraits traits) const;
     GLShader *generateShader(ShaderTraits traits);
+    /**
+     * Creates and links the shader, using the program binary cache if possible.
+     * @param traitLocations Whether the attribute names of the generated shaders are used
+     **/
+    GLShader *linkShader(const QByteArray &vertexSource, const QByteArray &fragmentSource, bool traitLocations);
+    QByteArray programBinaryKey(const QByteArray &vertexSource, const QByteArray &fragmentSource, bool traitLocations) const;
+    bool loadProgramBinary(GLShader *shader, const QByteArray &key) const;
+    void storeProgramBinary(GLShader *shader, const QByteArray &key) const;
 
     QStack<GLShader*> m_boundShaders;
     QHash<ShaderTraits, GLShader *> m_shaderHash;
     bool m_debug;
     QString m_resourcePath;
+    /**
+     * Directory of the program binaries for the current driver, empty if not supported.
+     **/
+    QString m_programBinaryPath;
+    QVector<GLint> m_programBinaryFormats;
     static ShaderManager *s_shaderManager;
 };
 
@@ -106,6 +106,13 @@ bool Client::manage(xcb_window_t w, bool isMapped)
     auto activitiesCookie = fetchActivities();
     auto applicationMenuServiceNameCookie = fetchApplicationMenuServiceName();
     auto applicationMenuObjectPathCookie = fetchApplicationMenuObjectPath();
+    auto syncCounterCookie = fetchSyncCounter();
+    auto nameCookie = fetchNameProperty(XCB_ATOM_WM_NAME);
+    auto iconicNameCookie = fetchNameProperty(XCB_ATOM_WM_ICON_NAME);
+    // select shape events before querying the shape, so that no change gets lost in between
+    if (Xcb::Extensions::self()->isShapeAvailable())
+        xcb_shape_select_input(connection(), window(), true);
+    auto shapeCookie = fetchShape(window());
 
     m_geometryHints.init(window());
     m_motif.init(window());
@@ -124,20 +131,18 @@ bool Client::manage(xcb_window_t w, bool isMapped)
     getResourceClass();
     readWmClientLeader(wmClientLeaderCookie);
     getWmClientMachine();
-    getSyncCounter();
+    readSyncCounter(syncCounterCookie);
     // First only read the caption text, so that setupWindowRules() can use it for matching,
     // and only then really set the caption using setCaption(), which checks for duplicates etc.
     // and also relies on rules already existing
-    cap_normal = readName();
+    cap_normal = readName(nameCookie);
     setupWindowRules(false);
     setCaption(cap_normal, true);
 
-    if (Xcb::Extensions::self()->isShapeAvailable())
-        xcb_shape_select_input(connection(), window(), true);
-    detectShape(window());
+    readShape(shapeCookie);
     readGtkFrameExtents(gtkFrameExtentsCookie);
     detectNoBorder();
-    fetchIconicName();
+    readIconicName(iconicNameCookie);
 
     // Needs to be done before readTransient() because of reading the group
     checkGroup();
@@ -125,6 +125,9 @@ Options::Options(QObject *parent)
     , m_glPreferBufferSwap(Options::defaultGlPreferBufferSwap())
     , m_glPlatformInterface(Options::defaultGlPlatformInterface())
     , m_windowsBlockCompositing(true)
+    , m_unredirectFullscreen(true)
+    , m_textureMemoryBudget(0)
+    , m_scriptCallbackTimeBudget(10)
     , OpTitlebarDblClick(Options::defaultOperationTitlebarDblClick())
     , CmdActiveTitlebar1(Options::defaultCommandActiveTitlebar1())
     , CmdActiveTitlebar2(Options::defaultCommandActiveTitlebar2())
@@ -714,6 +717,35 @@ void Options::setWindowsBlockCompositing(bool value)
     emit windowsBlockCompositingChanged();
 }
 
+void Options::setUnredirectFullscreen(bool value)
+{
+    if (m_unredirectFullscreen == value) {
+        return;
+    }
+    m_unredirectFullscreen = value;
+    emit unredirectFullscreenChanged();
+}
+
+void Options::setTextureMemoryBudget(int budget)
+{
+    budget = qMax(0, budget);
+    if (m_textureMemoryBudget == budget) {
+        return;
+    }
+    m_textureMemoryBudget = budget;
+    emit textureMemoryBudgetChanged();
+}
+
+void Options::setScriptCallbackTimeBudget(int budget)
+{
+    budget = qMax(0, budget);
+    if (m_scriptCallbackTimeBudget == budget) {
+        return;
+    }
+    m_scriptCallbackTimeBudget = budget;
+    emit scriptCallbackTimeBudgetChanged();
+}
+
 void Options::setGlPreferBufferSwap(char glPreferBufferSwap)
 {
     if (glPreferBufferSwap == 'a') {
@@ -887,6 +919,9 @@ void Options::syncFromKcfgc()
     setElectricBorderTiling(m_settings->electricBorderTiling());
     setElectricBorderCornerRatio(m_settings->electricBorderCornerRatio());
     setWindowsBlockCompositing(m_settings->windowsBlockCompositing());
+    setUnredirectFullscreen(m_settings->unredirectFullscreen());
+    setTextureMemoryBudget(m_settings->textureMemoryBudget());
+    setScriptCallbackTimeBudget(m_settings->callbackTimeBudget());
 
 }
 
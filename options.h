@@ -190,6 +190,9 @@ class KWIN_EXPORT Options : public QObject
     Q_PROPERTY(GlSwapStrategy glPreferBufferSwap READ glPreferBufferSwap WRITE setGlPreferBufferSwap NOTIFY glPreferBufferSwapChanged)
     Q_PROPERTY(KWin::OpenGLPlatformInterface glPlatformInterface READ glPlatformInterface WRITE setGlPlatformInterface NOTIFY glPlatformInterfaceChanged)
     Q_PROPERTY(bool windowsBlockCompositing READ windowsBlockCompositing WRITE setWindowsBlockCompositing NOTIFY windowsBlockCompositingChanged)
+    Q_PROPERTY(bool unredirectFullscreen READ isUnredirectFullscreen WRITE setUnredirectFullscreen NOTIFY unredirectFullscreenChanged)
+    Q_PROPERTY(int textureMemoryBudget READ textureMemoryBudget WRITE setTextureMemoryBudget NOTIFY textureMemoryBudgetChanged)
+    Q_PROPERTY(int scriptCallbackTimeBudget READ scriptCallbackTimeBudget WRITE setScriptCallbackTimeBudget NOTIFY scriptCallbackTimeBudgetChanged)
 public:
 
     explicit Options(QObject *parent = NULL);
@@ -595,6 +598,30 @@ public:
         return m_windowsBlockCompositing;
     }
 
+    /**
+     * Whether an opaque fullscreen window covering a screen bypasses compositing on X11.
+     **/
+    bool isUnredirectFullscreen() const
+    {
+        return m_unredirectFullscreen;
+    }
+
+    /**
+     * The texture memory in MiB above which the OpenGL compositor evicts caches, @c 0 for no limit.
+     **/
+    int textureMemoryBudget() const
+    {
+        return m_textureMemoryBudget;
+    }
+
+    /**
+     * The time in milliseconds a script callback may take before it gets reported, @c 0 to not report.
+     **/
+    int scriptCallbackTimeBudget() const
+    {
+        return m_scriptCallbackTimeBudget;
+    }
+
     QStringList modifierOnlyDBusShortcut(Qt::KeyboardModifier mod) const;
 
     // setters
@@ -659,6 +686,9 @@ public:
     void setGlPreferBufferSwap(char glPreferBufferSwap);
     void setGlPlatformInterface(OpenGLPlatformInterface interface);
     void setWindowsBlockCompositing(bool set);
+    void setUnredirectFullscreen(bool set);
+    void setTextureMemoryBudget(int budget);
+    void setScriptCallbackTimeBudget(int budget);
 
     // default values
     static WindowOperation defaultOperationTitlebarDblClick() {
@@ -850,6 +880,9 @@ Q_SIGNALS:
     void glPreferBufferSwapChanged();
     void glPlatformInterfaceChanged();
     void windowsBlockCompositingChanged();
+    void unredirectFullscreenChanged();
+    void textureMemoryBudgetChanged();
+    void scriptCallbackTimeBudgetChanged();
 
     void configChanged();
 
@@ -896,6 +929,9 @@ private:
     GlSwapStrategy m_glPreferBufferSwap;
     OpenGLPlatformInterface m_glPlatformInterface;
     bool m_windowsBlockCompositing;
+    bool m_unredirectFullscreen;
+    int m_textureMemoryBudget;
+    int m_scriptCallbackTimeBudget;
 
     WindowOperation OpTitlebarDblClick;
     WindowOperation opMaxButtonRightClick = defaultOperationMaxButtonRightClick();
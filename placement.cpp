@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QRect>
 #include <assert.h>
+#include <algorithm>
 
 #include <QTextStream>
 
@@ -189,6 +190,48 @@ static inline bool isIrrelevant(const AbstractClient *client, const AbstractClie
     return false;
 }
 
+/*!
+  Geometry of a window which has to be considered by the smart placement,
+  together with the factor its overlapping area is weighted with.
+ */
+struct PlacementObstacle {
+    int left;
+    int top;
+    int right;
+    int bottom;
+    int weight;
+};
+
+/*!
+  Collects the windows relevant for placing \a regarding on \a desktop,
+  so that the stacking order has to be walked only once per placement.
+ */
+static QVector<PlacementObstacle> placementObstacles(const AbstractClient *regarding, int desktop)
+{
+    QVector<PlacementObstacle> obstacles;
+    const ToplevelList &stacking = workspace()->stackingOrder();
+    obstacles.reserve(stacking.count());
+    for (auto it = stacking.constBegin(); it != stacking.constEnd(); ++it) {
+        AbstractClient *client = qobject_cast<AbstractClient*>(*it);
+        if (isIrrelevant(client, regarding, desktop)) {
+            continue;
+        }
+        PlacementObstacle obstacle;
+        obstacle.left = client->x();
+        obstacle.top = client->y();
+        obstacle.right = obstacle.left + client->width();
+        obstacle.bottom = obstacle.top + client->height();
+        if (client->keepAbove())
+            obstacle.weight = 16;
+        else if (client->keepBelow() && !client->isDock()) // ignore KeepBelow windows
+            obstacle.weight = 0; // for placement (see Client::belongsToLayer() for Dock)
+        else
+            obstacle.weight = 1;
+        obstacles << obstacle;
+    }
+    return obstacles;
+}
+
 /*!
   Place the client \a c according to a really smart placement algorithm :-)
 */
@@ -201,6 +244,12 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
      * Anthony Martin (amartin@engr.csulb.edu).
      * Xinerama supported added by Balaji Ramani (balaji@yablibli.com)
      * with ideas from xfce.
+     *
+     * The relevant windows are collected once. All positions tested for one y
+     * only depend on the windows intersecting the horizontal band [y, y + ch],
+     * so that band is computed once per row and kept sorted by the left edge,
+     * which allows to stop the overlap calculation at the first window right
+     * of the tested position.
      */
 
     const int none = 0, h_wrong = -1, w_wrong = -2; // overlap types
@@ -222,10 +271,31 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
     int ch = c->height() - 1;
     int cw = c->width()  - 1;
 
+    const QVector<PlacementObstacle> obstacles = placementObstacles(c, desktop);
+    // the windows intersecting the currently tested row, sorted by their left edge
+    QVector<const PlacementObstacle*> band;
+    band.reserve(obstacles.count());
+    bool bandValid = false;
+
     bool first_pass = true; //CT lame flag. Don't like it. What else would do?
 
     //loop over possible positions
     do {
+        if (!bandValid) {
+            band.clear();
+            for (const PlacementObstacle &obstacle : obstacles) {
+                if ((y < obstacle.bottom) && (obstacle.top < ch + y)) {
+                    band << &obstacle;
+                }
+            }
+            std::stable_sort(band.begin(), band.end(),
+                [] (const PlacementObstacle *a, const PlacementObstacle *b) {
+                    return a->left < b->left;
+                }
+            );
+            bandValid = true;
+        }
+
         //test if enough room in x and y directions
         if (y + ch > maxRect.bottom() && ch < maxRect.height())
             overlap = h_wrong; // this throws the algorithm to an exit
@@ -236,27 +306,18 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
 
             cxl = x; cxr = x + cw;
             cyt = y; cyb = y + ch;
-            ToplevelList::ConstIterator l;
-            for (l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd() ; ++l) {
-                AbstractClient *client = qobject_cast<AbstractClient*>(*l);
-                if (isIrrelevant(client, c, desktop)) {
-                    continue;
+            for (const PlacementObstacle *obstacle : band) {
+                if (obstacle->left >= cxr) {
+                    // sorted by left edge, no further window can overlap
+                    break;
                 }
-                xl = client->x();          yt = client->y();
-                xr = xl + client->width(); yb = yt + client->height();
-
-                //if windows overlap, calc the overall overlapping
-                if ((cxl < xr) && (cxr > xl) &&
-                        (cyt < yb) && (cyb > yt)) {
-                    xl = qMax(cxl, xl); xr = qMin(cxr, xr);
-                    yt = qMax(cyt, yt); yb = qMin(cyb, yb);
-                    if (client->keepAbove())
-                        overlap += 16 * (xr - xl) * (yb - yt);
-                    else if (client->keepBelow() && !client->isDock()) // ignore KeepBelow windows
-                        overlap += 0; // for placement (see Client::belongsToLayer() for Dock)
-                    else
-                        overlap += (xr - xl) * (yb - yt);
+                if (obstacle->right <= cxl) {
+                    continue;
                 }
+                //windows overlap, calc the overall overlapping
+                xl = qMax(cxl, obstacle->left); xr = qMin(cxr, obstacle->right);
+                yt = qMax(cyt, obstacle->top); yb = qMin(cyb, obstacle->bottom);
+                overlap += obstacle->weight * (xr - xl) * (yb - yt);
             }
         }
 
@@ -284,26 +345,17 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
             possible = maxRect.right();
             if (possible - cw > x) possible -= cw;
 
-            // compare to the position of each client on the same desk
-            ToplevelList::ConstIterator l;
-            for (l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd() ; ++l) {
-                AbstractClient *client = qobject_cast<AbstractClient*>(*l);
-                if (isIrrelevant(client, c, desktop)) {
-                    continue;
-                }
-
-                xl = client->x();          yt = client->y();
-                xr = xl + client->width(); yb = yt + client->height();
+            // compare to the position of each client in the current row,
+            // those are the clients without enough room above or under them,
+            // determine the first non-overlapped x position
+            for (const PlacementObstacle *obstacle : band) {
+                xl = obstacle->left;
+                xr = obstacle->right;
 
-                // if not enough room above or under the current tested client
-                // determine the first non-overlapped x position
-                if ((y < yb) && (yt < ch + y)) {
+                if ((xr > x) && (possible > xr)) possible = xr;
 
-                    if ((xr > x) && (possible > xr)) possible = xr;
-
-                    basket = xl - cw;
-                    if ((basket > x) && (possible > basket)) possible = basket;
-                }
+                basket = xl - cw;
+                if ((basket > x) && (possible > basket)) possible = basket;
             }
             x = possible;
         }
@@ -316,15 +368,9 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
             if (possible - ch > y) possible -= ch;
 
             //test the position of each window on the desk
-            ToplevelList::ConstIterator l;
-            for (l = workspace()->stackingOrder().constBegin(); l != workspace()->stackingOrder().constEnd() ; ++l) {
-                AbstractClient *client = qobject_cast<AbstractClient*>(*l);
-                if (isIrrelevant(client, c, desktop)) {
-                    continue;
-                }
-
-                xl = client->x();          yt = client->y();
-                xr = xl + client->width(); yb = yt + client->height();
+            for (const PlacementObstacle &obstacle : obstacles) {
+                yt = obstacle.top;
+                yb = obstacle.bottom;
 
                 // if not enough room to the left or right of the current tested client
                 // determine the first non-overlapped y position
@@ -333,6 +379,9 @@ void Placement::placeSmart(AbstractClient* c, const QRect& area, Policy /*next*/
                 basket = yt - ch;
                 if ((basket > y) && (possible > basket)) possible = basket;
             }
+            if (possible != y) {
+                bandValid = false;
+            }
             y = possible;
         }
     } while ((overlap != none) && (overlap != h_wrong) && (y < maxRect.bottom()));
@@ -31,8 +31,13 @@ KGlobalAccelImpl::~KGlobalAccelImpl() = default;
 
 bool KGlobalAccelImpl::grabKey(int key, bool grab)
 {
-    Q_UNUSED(key)
-    Q_UNUSED(grab)
+    if (m_shuttingDown) {
+        return true;
+    }
+    // KWin only forwards key presses for grabbed keys
+    if (KWin::InputRedirection *input = KWin::InputRedirection::self()) {
+        input->registerGlobalAccelKey(key, grab);
+    }
     return true;
 }
 
@@ -49,10 +54,9 @@ void KGlobalAccelImpl::setEnabled(bool enabled)
             m_inputDestroyedConnection = connect(s_input, &QObject::destroyed, this, [this] { m_shuttingDown = true; });
         }
     }
-    s_input->registerGlobalAccel(enabled ? this : nullptr);
-}
-
-bool KGlobalAccelImpl::checkKeyPressed(int keyQt)
-{
-    return keyPressed(keyQt);
+    if (enabled) {
+        s_input->registerGlobalAccel(this, [this] (int keyQt) { return keyPressed(keyQt); });
+    } else {
+        s_input->registerGlobalAccel(nullptr);
+    }
 }
@@ -37,9 +37,6 @@ public:
     bool grabKey(int key, bool grab) override;
     void setEnabled(bool) override;
 
-public Q_SLOTS:
-    bool checkKeyPressed(int keyQt);
-
 private:
     bool m_shuttingDown = false;
     QMetaObject::Connection m_inputDestroyedConnection;
@@ -592,9 +592,11 @@ void DrmBackend::initCursor()
             if (usesSoftwareCursor()) {
                 return;
             }
+            // m_cursorIndex references the back buffer, the current image is in the other one
+            DrmDumbBuffer *c = m_cursor[(m_cursorIndex + 1) % 2];
             for (auto it = m_outputs.constBegin(); it != m_outputs.constEnd(); ++it) {
                 if (m_cursorEnabled) {
-                    (*it)->showCursor(m_cursor[m_cursorIndex]);
+                    (*it)->showCursor(c);
                 } else {
                     (*it)->hideCursor();
                 }
@@ -619,6 +621,7 @@ void DrmBackend::initCursor()
             return false;
         }
         m_cursor[index]->image()->fill(Qt::transparent);
+        m_cursorCacheKey[index] = 0;
         return true;
     };
     if (!createCursor(0) || !createCursor(1)) {
@@ -655,17 +658,48 @@ void DrmBackend::updateCursor()
         doHideCursor();
         return;
     }
-    QImage *c = m_cursor[m_cursorIndex]->image();
-    c->fill(Qt::transparent);
-    QPainter p;
-    p.begin(c);
-    p.drawImage(QPoint(0, 0), cursorImage);
-    p.end();
+    // m_cursorIndex references the buffer which is not shown, the other one is on screen
+    const qint64 cacheKey = cursorImage.cacheKey();
+    if (m_cursorCacheKey[(m_cursorIndex + 1) % 2] == cacheKey) {
+        // image is already shown, only the hotspot might have changed
+        markCursorAsRendered();
+        moveCursor();
+        return;
+    }
+    if (m_cursorCacheKey[m_cursorIndex] != cacheKey) {
+        // the back buffer does not hold e.g. the previous frame of an animated cursor
+        copyCursorImage(cursorImage, m_cursor[m_cursorIndex]->image());
+        m_cursorCacheKey[m_cursorIndex] = cacheKey;
+    }
 
     setCursor();
     moveCursor();
 }
 
+void DrmBackend::copyCursorImage(const QImage &source, QImage *target)
+{
+    if (source.format() != target->format()) {
+        target->fill(Qt::transparent);
+        QPainter p(target);
+        p.drawImage(QPoint(0, 0), source);
+        return;
+    }
+    // same format, copy the lines directly and clear what the cursor does not cover
+    const int height = qMin(source.height(), target->height());
+    const int width = qMin(source.width(), target->width());
+    const int bytes = width * target->depth() / 8;
+    const int lineBytes = target->bytesPerLine();
+    uchar *bits = target->bits();
+    for (int y = 0; y < height; ++y) {
+        uchar *line = bits + y * lineBytes;
+        memcpy(line, source.constScanLine(y), bytes);
+        memset(line + bytes, 0, lineBytes - bytes);
+    }
+    if (height < target->height()) {
+        memset(bits + height * lineBytes, 0, (target->height() - height) * lineBytes);
+    }
+}
+
 void DrmBackend::doShowCursor()
 {
     updateCursor();
@@ -679,6 +713,8 @@ void DrmBackend::doHideCursor()
     for (auto it = m_outputs.constBegin(); it != m_outputs.constEnd(); ++it) {
         (*it)->hideCursor();
     }
+    // nothing is shown any more, the next update has to set the cursor again
+    m_cursorCacheKey[(m_cursorIndex + 1) % 2] = 0;
 }
 
 void DrmBackend::moveCursor()
@@ -139,6 +139,7 @@ private:
     void updateOutputs();
     void setCursor();
     void updateCursor();
+    void copyCursorImage(const QImage &source, QImage *target);
     void moveCursor();
     void initCursor();
     void outputDpmsChanged();
@@ -161,6 +162,10 @@ private:
     bool m_atomicModeSetting = false;
     bool m_cursorEnabled = false;
     int m_cursorIndex = 0;
+    /**
+     * QImage::cacheKey of the cursor image in the respective buffer of m_cursor, 0 if unknown.
+     **/
+    qint64 m_cursorCacheKey[2] = {0, 0};
     int m_pageFlipsPending = 0;
     bool m_active = false;
     // all available planes: primarys, cursors and overlays
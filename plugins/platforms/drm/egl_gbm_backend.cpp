@@ -292,7 +292,7 @@ void EglGbmBackend::endRenderingFrame(const QRegion &renderedRegion, const QRegi
 void EglGbmBackend::endRenderingFrameForScreen(int screenId, const QRegion &renderedRegion, const QRegion &damagedRegion)
 {
     Output &o = m_outputs[screenId];
-    if (damagedRegion.intersected(o.output->geometry()).isEmpty() && screenId == 0) {
+    if (damagedRegion.intersected(o.output->geometry()).isEmpty()) {
 
         // If the damaged region of a window is fully occluded, the only
         // rendering done, if any, will have been to repair a reused back
@@ -304,22 +304,15 @@ void EglGbmBackend::endRenderingFrameForScreen(int screenId, const QRegion &rend
         if (!renderedRegion.intersected(o.output->geometry()).isEmpty())
             glFlush();
 
-        for (auto &o: m_outputs) {
-            o.bufferAge = 1;
-        }
+        o.bufferAge = 1;
         return;
     }
     presentOnOutput(o);
 
     // Save the damaged region to history
-    // Note: damage history is only collected for the first screen. For any other screen full repaints
-    // are triggered. This is due to a limitation in Scene::paintGenericScreen which resets the Toplevel's
-    // repaint. So multiple calls to Scene::paintScreen as it's done in multi-output rendering only
-    // have correct damage information for the first screen. If we try to track damage nevertheless,
-    // it creates artifacts. So for the time being we work around the problem by only supporting buffer
-    // age on the first output. To properly support buffer age on all outputs the rendering needs to
-    // be refactored in general.
-    if (supportsBufferAge() && screenId == 0) {
+    // Note: the Scene takes the window repaints once per frame for all outputs, so the damage
+    // is correct for every output and not just the first one.
+    if (supportsBufferAge()) {
         if (o.damageHistory.count() > 10) {
             o.damageHistory.removeLast();
         }
@@ -129,10 +129,35 @@ bool FramebufferBackend::queryScreenInfo()
     m_bitsPerPixel = varinfo.bits_per_pixel;
     m_bufferLength = fixinfo.smem_len;
     m_bytesPerLine = fixinfo.line_length;
+    if (fixinfo.ypanstep > 0 && varinfo.yres_virtual >= varinfo.yres * 2 &&
+            m_bufferLength >= quint32(m_bytesPerLine) * varinfo.yres * 2) {
+        m_pageCount = 2;
+    } else {
+        m_pageCount = 1;
+    }
+    qCDebug(KWIN_FB) << "Frame buffer pages: " << m_pageCount;
 
     return true;
 }
 
+bool FramebufferBackend::showPage(int index)
+{
+    if (m_fd < 0 || index >= m_pageCount) {
+        return false;
+    }
+    fb_var_screeninfo varinfo;
+    if (ioctl(m_fd, FBIOGET_VSCREENINFO, &varinfo) < 0) {
+        return false;
+    }
+    varinfo.xoffset = 0;
+    varinfo.yoffset = index * varinfo.yres;
+    if (ioctl(m_fd, FBIOPAN_DISPLAY, &varinfo) < 0) {
+        qCWarning(KWIN_FB) << "Failed to pan the frame buffer";
+        return false;
+    }
+    return true;
+}
+
 void FramebufferBackend::map()
 {
     if (m_memory) {
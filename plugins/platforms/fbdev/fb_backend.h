@@ -77,6 +77,18 @@ public:
     bool isBGR() const {
         return m_bgr;
     }
+    /**
+     * @returns the number of screen sized pages in the mapped memory. It is @c 2 if the
+     * driver can pan between them, which allows to double buffer, otherwise @c 1.
+     **/
+    int pageCount() const {
+        return m_pageCount;
+    }
+    /**
+     * Pans the display to the page with @p index.
+     * @returns @c false if the driver failed to pan
+     **/
+    bool showPage(int index);
 
 private:
     void openFrameBuffer();
@@ -97,6 +109,7 @@ private:
     int m_fd = -1;
     quint32 m_bufferLength = 0;
     int m_bytesPerLine = 0;
+    int m_pageCount = 1;
     void *m_memory = nullptr;
     QImage::Format m_imageFormat = QImage::Format_Invalid;
     bool m_bgr = false;
@@ -32,6 +32,7 @@ FramebufferQPainterBackend::FramebufferQPainterBackend(FramebufferBackend *backe
     , QPainterBackend()
     , m_renderBuffer(backend->size(), QImage::Format_RGB32)
     , m_backend(backend)
+    , m_pageCount(backend->pageCount())
 {
     m_renderBuffer.fill(Qt::black);
 
@@ -43,9 +44,14 @@ FramebufferQPainterBackend::FramebufferQPainterBackend(FramebufferBackend *backe
                           backend->bytesPerLine(), backend->imageFormat());
 
     m_backBuffer.fill(Qt::black);
+    if (m_pageCount > 1 && !m_backend->showPage(m_frontPage)) {
+        m_pageCount = 1;
+    }
     connect(VirtualTerminal::self(), &VirtualTerminal::activeChanged, this,
         [this] (bool active) {
             if (active) {
+                // another user of the frame buffer might have changed both pages
+                m_frontPageDamage = QRect(QPoint(0, 0), m_renderBuffer.size());
                 Compositor::self()->bufferSwapComplete();
                 Compositor::self()->addRepaintFull();
             } else {
@@ -74,12 +80,60 @@ void FramebufferQPainterBackend::prepareRenderingFrame()
 void FramebufferQPainterBackend::present(int mask, const QRegion &damage)
 {
     Q_UNUSED(mask)
-    Q_UNUSED(damage)
     if (!VirtualTerminal::self()->isActive()) {
         return;
     }
+    // the render buffer keeps its content, so only the damaged parts need to be copied
+    const QRegion region = damage & QRect(QPoint(0, 0), m_renderBuffer.size());
+    if (m_pageCount == 1) {
+        copyToFramebuffer(region | m_frontPageDamage, m_frontPage);
+        m_frontPageDamage = QRegion();
+        return;
+    }
+    // the back page still shows the frame before the front page
+    const int backPage = 1 - m_frontPage;
+    copyToFramebuffer(region | m_frontPageDamage, backPage);
+    if (m_backend->showPage(backPage)) {
+        m_frontPage = backPage;
+        m_frontPageDamage = region;
+    } else {
+        // keep rendering into the shown page
+        m_pageCount = 1;
+        copyToFramebuffer(QRect(QPoint(0, 0), m_renderBuffer.size()), m_frontPage);
+        m_frontPageDamage = QRegion();
+    }
+}
+
+void FramebufferQPainterBackend::copyToFramebuffer(const QRegion &region, int page)
+{
+    if (region.isEmpty()) {
+        return;
+    }
+    const int pageOffset = page * m_renderBuffer.height();
+    if (m_backBuffer.format() == QImage::Format_RGB32) {
+        // same format as the render buffer, so just copy the lines
+        uchar *memory = static_cast<uchar*>(m_backend->mappedMemory());
+        const int bytesPerLine = m_backend->bytesPerLine();
+        for (const QRect &rect : region.rects()) {
+            const int offset = rect.x() * 4;
+            const int length = rect.width() * 4;
+            for (int y = rect.top(); y <= rect.bottom(); ++y) {
+                memcpy(memory + (pageOffset + y) * bytesPerLine + offset,
+                       m_renderBuffer.constScanLine(y) + offset, length);
+            }
+        }
+        return;
+    }
     QPainter p(&m_backBuffer);
-    p.drawImage(QPoint(0, 0), m_backend->isBGR() ? m_renderBuffer.rgbSwapped() : m_renderBuffer);
+    p.setCompositionMode(QPainter::CompositionMode_Source);
+    for (const QRect &rect : region.rects()) {
+        const QPoint target = rect.topLeft() + QPoint(0, pageOffset);
+        if (m_backend->isBGR()) {
+            p.drawImage(target, m_renderBuffer.copy(rect).rgbSwapped());
+        } else {
+            p.drawImage(target, m_renderBuffer, rect);
+        }
+    }
 }
 
 bool FramebufferQPainterBackend::usesOverlayWindow() const
@@ -42,9 +42,20 @@ public:
     void present(int mask, const QRegion &damage) override;
 
 private:
+    /**
+     * Copies @p region of the render buffer into the page @p page of the frame buffer,
+     * converting to the format of the frame buffer.
+     **/
+    void copyToFramebuffer(const QRegion &region, int page);
     QImage m_renderBuffer;
     QImage m_backBuffer;
     FramebufferBackend *m_backend;
+    int m_pageCount;
+    int m_frontPage = 0;
+    /**
+     * What changed in the front page since the back page got shown the last time.
+     **/
+    QRegion m_frontPageDamage;
 };
 
 }
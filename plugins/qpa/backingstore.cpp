@@ -26,6 +26,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <KWayland/Client/shm_pool.h>
 #include <KWayland/Client/surface.h>
 
+#include <QPainter>
+
 namespace KWin
 {
 namespace QPA
@@ -71,21 +73,23 @@ void BackingStore::resize(const QSize &size, const QRegion &staticContents)
 
 void BackingStore::flush(QWindow *window, const QRegion &region, const QPoint &offset)
 {
-    Q_UNUSED(region)
     Q_UNUSED(offset)
     auto s = static_cast<Window *>(window->handle())->surface();
     if (!s) {
         return;
     }
+    const QRegion damage = region & QRect(QPoint(0, 0), m_backBuffer.size());
+    if (damage.isEmpty()) {
+        return;
+    }
     s->attachBuffer(m_buffer);
-    // TODO: proper damage region
-    s->damage(QRect(QPoint(0, 0), m_backBuffer.size()));
+    s->damage(damage);
     s->commit(KWayland::Client::Surface::CommitFlag::None);
     waylandServer()->internalClientConection()->flush();
-    waylandServer()->dispatch();
+    waylandServer()->scheduleDispatch();
 }
 
-void BackingStore::beginPaint(const QRegion&)
+void BackingStore::beginPaint(const QRegion &region)
 {
     if (m_buffer) {
         auto b = m_buffer.toStrongRef();
@@ -109,7 +113,17 @@ void BackingStore::beginPaint(const QRegion&)
     b->setUsed(true);
     m_backBuffer = QImage(b->address(), m_size.width(), m_size.height(), QImage::Format_ARGB32_Premultiplied);
     if (oldBuffer) {
-        b->copy(oldBuffer->address());
+        // the region is going to be repainted, only the remaining content has to be carried over
+        const QImage oldContent(oldBuffer->address(), m_size.width(), m_size.height(), QImage::Format_ARGB32_Premultiplied);
+        QPainter p(&m_backBuffer);
+        p.setCompositionMode(QPainter::CompositionMode_Source);
+        const QRegion carriedOver = QRegion(m_backBuffer.rect()) - region;
+        for (const QRect &rect : carriedOver.rects()) {
+            p.drawImage(rect, oldContent, rect);
+        }
+        for (const QRect &rect : (region & m_backBuffer.rect()).rects()) {
+            p.fillRect(rect, Qt::transparent);
+        }
     } else {
         m_backBuffer.fill(Qt::transparent);
     }
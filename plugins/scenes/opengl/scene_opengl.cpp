@@ -44,6 +44,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "overlaywindow.h"
 #include "screens.h"
 #include "cursor.h"
+#include "texturememorymanager.h"
 #include "decorations/decoratedclient.h"
 #include <logging.h>
 
@@ -657,6 +658,7 @@ qint64 SceneOpenGL::paint(QRegion damage, ToplevelList toplevels)
     if (m_backend->perScreenRendering()) {
         // trigger start render timer
         m_backend->prepareRenderingFrame();
+        beginMultiOutputFrame();
         for (int i = 0; i < screens()->count(); ++i) {
             const QRect &geo = screens()->geometry(i);
             QRegion update;
@@ -669,6 +671,7 @@ qint64 SceneOpenGL::paint(QRegion damage, ToplevelList toplevels)
 
             const GLenum status = glGetGraphicsResetStatus();
             if (status != GL_NO_ERROR) {
+                endMultiOutputFrame();
                 handleGraphicsReset(status);
                 return 0;
             }
@@ -684,6 +687,7 @@ qint64 SceneOpenGL::paint(QRegion damage, ToplevelList toplevels)
 
             GLVertexBuffer::streamingBuffer()->framePosted();
         }
+        endMultiOutputFrame();
     } else {
         m_backend->makeCurrent();
         QRegion repaint = m_backend->prepareRenderingFrame();
@@ -1000,6 +1004,8 @@ SceneOpenGL2::SceneOpenGL2(OpenGLBackend *backend, QObject *parent)
         init_ok = false;
         return;
     }
+    // don't stutter on the first window which fades or gets desaturated
+    ShaderManager::instance()->precompileShaders();
 
     qCDebug(KWIN_OPENGL) << "OpenGL 2 compositing successfully initialized";
     init_ok = true;
@@ -1544,13 +1550,19 @@ OpenGLWindowPixmap::OpenGLWindowPixmap(Scene::Window *window, SceneOpenGL* scene
     : WindowPixmap(window)
     , m_texture(scene->createTexture())
     , m_scene(scene)
+    , m_textureMemory(TextureMemoryManager::Owner::WindowPixmap, window->window())
 {
+    m_textureMemory.setEvictCallback([window, scene] {
+        scene->makeOpenGLContextCurrent();
+        window->releaseHiddenPixmaps();
+    });
 }
 
 OpenGLWindowPixmap::OpenGLWindowPixmap(const QPointer<KWayland::Server::SubSurfaceInterface> &subSurface, WindowPixmap *parent, SceneOpenGL *scene)
     : WindowPixmap(subSurface, parent)
     , m_texture(scene->createTexture())
     , m_scene(scene)
+    , m_textureMemory(TextureMemoryManager::Owner::WindowPixmap, parent->toplevel())
 {
 }
 
@@ -1578,6 +1590,7 @@ bool OpenGLWindowPixmap::bind()
         for (auto it = children().constBegin(); it != children().constEnd(); ++it) {
             static_cast<OpenGLWindowPixmap*>(*it)->bind();
         }
+        m_textureMemory.setSize(m_texture->size());
         return true;
     }
     // also bind all children, needs to be done before checking isValid
@@ -1598,6 +1611,7 @@ bool OpenGLWindowPixmap::bind()
         if (subSurface().isNull()) {
             toplevel()->resetDamage();
         }
+        m_textureMemory.setSize(m_texture->size());
     } else
         qCDebug(KWIN_OPENGL) << "Failed to bind window";
     return success;
@@ -2062,6 +2076,8 @@ private:
     DecorationShadowTextureCache() = default;
     struct Data {
         QSharedPointer<GLTexture> texture;
+        // accounted once for all windows sharing the texture
+        QSharedPointer<TextureMemoryEntry> textureMemory;
         QVector<SceneOpenGLShadow*> shadows;
     };
     QHash<KDecoration2::DecorationShadow*, Data> m_cache;
@@ -2116,12 +2132,15 @@ QSharedPointer<GLTexture> DecorationShadowTextureCache::getTexture(SceneOpenGLSh
     Data d;
     d.shadows << shadow;
     d.texture = QSharedPointer<GLTexture>::create(shadow->decorationShadowImage());
+    d.textureMemory = QSharedPointer<TextureMemoryEntry>::create(TextureMemoryManager::Owner::Shadow);
+    d.textureMemory->setSize(d.texture->size());
     m_cache.insert(decoShadow.data(), d);
     return d.texture;
 }
 
 SceneOpenGLShadow::SceneOpenGLShadow(Toplevel *toplevel)
     : Shadow(toplevel)
+    , m_textureMemory(TextureMemoryManager::Owner::Shadow, toplevel)
 {
 }
 
@@ -2253,6 +2272,7 @@ bool SceneOpenGLShadow::prepareBackend()
         // simplifies a lot by going directly to
         effects->makeOpenGLContextCurrent();
         m_texture = DecorationShadowTextureCache::instance().getTexture(this);
+        m_textureMemory.setSize(QSize());
 
         return true;
     }
@@ -2320,6 +2340,7 @@ bool SceneOpenGLShadow::prepareBackend()
         m_texture->bind();
         m_texture->setSwizzle(GL_ZERO, GL_ZERO, GL_ZERO, GL_RED);
     }
+    m_textureMemory.setSize(m_texture->size(), m_texture->internalFormat() == GL_R8 ? 1 : 4);
 
     return true;
 }
@@ -2327,6 +2348,7 @@ bool SceneOpenGLShadow::prepareBackend()
 SceneOpenGLDecorationRenderer::SceneOpenGLDecorationRenderer(Decoration::DecoratedClientImpl *client)
     : Renderer(client)
     , m_texture()
+    , m_textureMemory(TextureMemoryManager::Owner::Decoration, client->client())
 {
     connect(this, &Renderer::renderScheduled, client->client(), static_cast<void (AbstractClient::*)(const QRect&)>(&AbstractClient::addRepaint));
 }
@@ -2423,6 +2445,7 @@ void SceneOpenGLDecorationRenderer::resizeTexture()
     } else {
         m_texture.reset();
     }
+    m_textureMemory.setSize(m_texture ? m_texture->size() : QSize());
 }
 
 void SceneOpenGLDecorationRenderer::reparent(Deleted *deleted)
@@ -29,6 +29,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include "decorations/decorationrenderer.h"
 #include "platformsupport/scenes/opengl/backend.h"
+#include "texturememorymanager.h"
 
 namespace KWin
 {
@@ -229,6 +230,7 @@ private:
     explicit OpenGLWindowPixmap(const QPointer<KWayland::Server::SubSurfaceInterface> &subSurface, WindowPixmap *parent, SceneOpenGL *scene);
     QScopedPointer<SceneOpenGLTexture> m_texture;
     SceneOpenGL *m_scene;
+    TextureMemoryEntry m_textureMemory;
 };
 
 class SceneOpenGL::EffectFrame
@@ -290,6 +292,7 @@ protected:
     virtual bool prepareBackend();
 private:
     QSharedPointer<GLTexture> m_texture;
+    TextureMemoryEntry m_textureMemory;
 };
 
 class SceneOpenGLDecorationRenderer : public Decoration::Renderer
@@ -319,6 +322,7 @@ public:
 private:
     void resizeTexture();
     QScopedPointer<GLTexture> m_texture;
+    TextureMemoryEntry m_textureMemory;
 };
 
 inline bool SceneOpenGL::hasPendingFlush() const
@@ -102,6 +102,7 @@ qint64 SceneQPainter::paint(QRegion damage, ToplevelList toplevels)
             damage = screens()->geometry();
         }
         QRegion overallUpdate;
+        beginMultiOutputFrame();
         for (int i = 0; i < screens()->count(); ++i) {
             const QRect geometry = screens()->geometry(i);
             QImage *buffer = m_backend->bufferForScreen(i);
@@ -120,6 +121,7 @@ qint64 SceneQPainter::paint(QRegion damage, ToplevelList toplevels)
             m_painter->restore();
             m_painter->end();
         }
+        endMultiOutputFrame();
         m_backend->showOverlay();
         m_backend->present(mask, overallUpdate);
     } else {
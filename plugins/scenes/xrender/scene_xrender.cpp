@@ -53,6 +53,9 @@ ScreenPaintData SceneXrender::screen_paint;
 #define DOUBLE_TO_FIXED(d) ((xcb_render_fixed_t) ((d) * 65536))
 #define FIXED_TO_DOUBLE(f) ((double) ((f) / 65536.0))
 
+// shared by shadows and decorations, so that a serial never matches one of another object
+static quint64 s_pictureSerial = 0;
+
 
 //****************************************
 // XRenderBackend
@@ -587,12 +590,6 @@ void SceneXrender::Window::performPaint(int mask, QRegion region, WindowPaintDat
         right  = renderer->picture(SceneXRenderDecorationRenderer::DecorationPart::Right);
         bottom = renderer->picture(SceneXRenderDecorationRenderer::DecorationPart::Bottom);
     }
-    if (!noBorder) {
-        MAP_RECT_TO_TARGET(dtr);
-        MAP_RECT_TO_TARGET(dlr);
-        MAP_RECT_TO_TARGET(drr);
-        MAP_RECT_TO_TARGET(dbr);
-    }
     //END deco preparations
 
     //BEGIN shadow preparations
@@ -601,6 +598,58 @@ void SceneXrender::Window::performPaint(int mask, QRegion region, WindowPaintDat
 
     if (wantShadow) {
         m_xrenderShadow->layoutShadowRects(str, strr, srr, sbrr, sbr, sblr, slr, stlr);
+    }
+    //END shadow preparations
+
+    //BEGIN frame strip preparations
+    // Composite shadow and decoration into strips around the client once, instead of
+    // twelve requests per frame. That changes nothing visible as long as the decoration
+    // does not overlap the client and the client covers any shadow below it.
+    FrameTiles tiles;
+    if (wantShadow) {
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementTopLeft), stlr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementTop), str});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementTopRight), strr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementLeft), slr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementRight), srr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementBottomLeft), sblr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementBottom), sbr});
+        tiles.append({m_xrenderShadow->picture(SceneXRenderShadow::ShadowElementBottomRight), sbrr});
+    }
+    if (!noBorder) {
+        tiles.append({top, dtr});
+        tiles.append({left, dlr});
+        tiles.append({right, drr});
+        tiles.append({bottom, dbr});
+    }
+    const bool clientPainted = !(client && client->isShade());
+    const bool coversShadow = opaque || blitInTempPixmap;
+    bool useFrameStrips = !tiles.isEmpty() && clientPainted && (blitInTempPixmap || !scaled);
+    if (useFrameStrips && !coversShadow) {
+        for (const FrameTile &tile : tiles) {
+            if (tile.rect.intersects(cr)) {
+                useFrameStrips = false;
+                break;
+            }
+        }
+    }
+    QRect frameStripTargets[FrameStripCount];
+    if (useFrameStrips) {
+        updateFrameStrips(cr, tiles, renderer ? renderer->serial() : 0, wantShadow ? m_xrenderShadow->serial() : 0);
+        for (int i = 0; i < FrameStripCount; ++i) {
+            frameStripTargets[i] = m_frameStripRects[i];
+            MAP_RECT_TO_TARGET(frameStripTargets[i]);
+        }
+    }
+    //END frame strip preparations
+
+    if (!noBorder) {
+        MAP_RECT_TO_TARGET(dtr);
+        MAP_RECT_TO_TARGET(dlr);
+        MAP_RECT_TO_TARGET(drr);
+        MAP_RECT_TO_TARGET(dbr);
+    }
+    if (wantShadow) {
         MAP_RECT_TO_TARGET(stlr);
         MAP_RECT_TO_TARGET(str);
         MAP_RECT_TO_TARGET(strr);
@@ -610,7 +659,6 @@ void SceneXrender::Window::performPaint(int mask, QRegion region, WindowPaintDat
         MAP_RECT_TO_TARGET(sblr);
         MAP_RECT_TO_TARGET(slr);
     }
-    //BEGIN end preparations
 
     //BEGIN client preparations
     QRect dr = cr;
@@ -635,8 +683,21 @@ void SceneXrender::Window::performPaint(int mask, QRegion region, WindowPaintDat
 xcb_render_composite(connection(), XCB_RENDER_PICT_OP_OVER, m_xrenderShadow->picture(SceneXRenderShadow::ShadowElement##_TILE_), \
                  shadowAlpha, renderTarget, 0, 0, 0, 0, _RECT_.x(), _RECT_.y(), _RECT_.width(), _RECT_.height())
 
-        //shadow
-        if (wantShadow) {
+        if (useFrameStrips) {
+            xcb_render_picture_t frameAlpha = XCB_RENDER_PICTURE_NONE;
+            if (!opaque) {
+                frameAlpha = xRenderBlendPicture(data.opacity());
+            }
+            for (int i = 0; i < FrameStripCount; ++i) {
+                const QRect &r = frameStripTargets[i];
+                if (r.isEmpty()) {
+                    continue;
+                }
+                xcb_render_composite(connection(), XCB_RENDER_PICT_OP_OVER, m_frameStrips[i], frameAlpha, renderTarget,
+                                     0, 0, 0, 0, r.x(), r.y(), r.width(), r.height());
+            }
+        } else if (wantShadow) {
+            //shadow
             xcb_render_picture_t shadowAlpha = XCB_RENDER_PICTURE_NONE;
             if (!opaque) {
                 shadowAlpha = xRenderBlendPicture(data.opacity());
@@ -693,7 +754,7 @@ xcb_render_composite(connection(), XCB_RENDER_PICT_OP_OVER, m_xrenderShadow->pic
                 transformed_shape = QRegion();
         }
 
-        if (client || deleted) {
+        if ((client || deleted) && !useFrameStrips) {
             if (!noBorder) {
                 xcb_render_picture_t decorationAlpha = xRenderBlendPicture(data.opacity());
                 auto renderDeco = [decorationAlpha, renderTarget](xcb_render_picture_t deco, const QRect &rect) {
@@ -752,6 +813,58 @@ xcb_render_composite(connection(), XCB_RENDER_PICT_OP_OVER, m_xrenderShadow->pic
         scene_setXRenderOffscreenTarget(*s_tempPicture);
 }
 
+void SceneXrender::Window::updateFrameStrips(const QRect &clientRect, const FrameTiles &tiles, quint64 decorationSerial, quint64 shadowSerial)
+{
+    QVector<QRect> layout;
+    layout.reserve(tiles.count() + 1);
+    layout << clientRect;
+    QRect bounding = clientRect;
+    for (const FrameTile &tile : tiles) {
+        layout << tile.rect;
+        bounding |= tile.rect;
+    }
+    if (layout == m_frameLayout && decorationSerial == m_frameDecorationSerial && shadowSerial == m_frameShadowSerial) {
+        return;
+    }
+    m_frameLayout = layout;
+    m_frameDecorationSerial = decorationSerial;
+    m_frameShadowSerial = shadowSerial;
+
+    const QRect strips[FrameStripCount] = {
+        QRect(QPoint(bounding.left(), bounding.top()), QPoint(bounding.right(), clientRect.top() - 1)),
+        QRect(QPoint(bounding.left(), clientRect.top()), QPoint(clientRect.left() - 1, clientRect.bottom())),
+        QRect(QPoint(clientRect.right() + 1, clientRect.top()), QPoint(bounding.right(), clientRect.bottom())),
+        QRect(QPoint(bounding.left(), clientRect.bottom() + 1), QPoint(bounding.right(), bounding.bottom()))
+    };
+    xcb_connection_t *c = connection();
+    for (int i = 0; i < FrameStripCount; ++i) {
+        const QRect &strip = strips[i];
+        if (strip.isEmpty()) {
+            m_frameStrips[i] = XRenderPicture();
+            m_frameStripRects[i] = QRect();
+            continue;
+        }
+        if (m_frameStripRects[i].size() != strip.size()) {
+            xcb_pixmap_t pix = xcb_generate_id(c);
+            xcb_create_pixmap(c, 32, pix, rootWindow(), strip.width(), strip.height());
+            m_frameStrips[i] = XRenderPicture(pix, 32);
+            xcb_free_pixmap(c, pix);
+        }
+        m_frameStripRects[i] = strip;
+        const xcb_rectangle_t rect = {0, 0, uint16_t(strip.width()), uint16_t(strip.height())};
+        xcb_render_fill_rectangles(c, XCB_RENDER_PICT_OP_SRC, m_frameStrips[i], preMultiply(Qt::transparent), 1, &rect);
+        for (const FrameTile &tile : tiles) {
+            const QRect r = tile.rect & strip;
+            if (tile.picture == XCB_RENDER_PICTURE_NONE || r.isEmpty()) {
+                continue;
+            }
+            xcb_render_composite(c, XCB_RENDER_PICT_OP_OVER, tile.picture, XCB_RENDER_PICTURE_NONE, m_frameStrips[i],
+                                 r.x() - tile.rect.x(), r.y() - tile.rect.y(), 0, 0,
+                                 r.x() - strip.x(), r.y() - strip.y(), r.width(), r.height());
+        }
+    }
+}
+
 void SceneXrender::Window::setPictureFilter(xcb_render_picture_t pic, Scene::ImageFilterType filter)
 {
     QByteArray filterName;
@@ -1168,6 +1281,7 @@ bool SceneXRenderShadow::prepareBackend()
         m_pictures[i] = new XRenderPicture(shadowPixmap(ShadowElements(i)).toImage());
         xcb_render_change_picture(connection(), *m_pictures[i], XCB_RENDER_CP_REPEAT, values);
     }
+    m_serial = ++s_pictureSerial;
     return true;
 }
 
@@ -1240,6 +1354,7 @@ void SceneXRenderDecorationRenderer::render()
     renderPart(right.intersected(geometry),  right.topLeft(),  int(DecorationPart::Right));
     renderPart(bottom.intersected(geometry), bottom.topLeft(), int(DecorationPart::Bottom));
     xcb_flush(c);
+    m_serial = ++s_pictureSerial;
 }
 
 void SceneXRenderDecorationRenderer::resizePixmaps()
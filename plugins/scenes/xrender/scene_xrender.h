@@ -25,6 +25,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "shadow.h"
 #include "decorations/decorationrenderer.h"
 
+#include <QVarLengthArray>
+
 #ifdef KWIN_HAVE_XRENDER_COMPOSITING
 
 namespace KWin
@@ -200,13 +202,39 @@ public:
 protected:
     virtual WindowPixmap* createWindowPixmap();
 private:
+    struct FrameTile {
+        xcb_render_picture_t picture;
+        QRect rect;
+    };
+    typedef QVarLengthArray<FrameTile, 12> FrameTiles;
+    enum FrameStrip {
+        FrameStripTop,
+        FrameStripLeft,
+        FrameStripRight,
+        FrameStripBottom,
+        FrameStripCount
+    };
     QRect mapToScreen(int mask, const WindowPaintData &data, const QRect &rect) const;
     QPoint mapToScreen(int mask, const WindowPaintData &data, const QPoint &point) const;
     void prepareTempPixmap();
     void setPictureFilter(xcb_render_picture_t pic, ImageFilterType filter);
+    /**
+     * Composites the shadow and decoration @p tiles into the frame strips around @p clientRect,
+     * unless the strips already hold them.
+     **/
+    void updateFrameStrips(const QRect &clientRect, const FrameTiles &tiles, quint64 decorationSerial, quint64 shadowSerial);
     SceneXrender *m_scene;
     xcb_render_pictformat_t format;
     QRegion transformed_shape;
+    /**
+     * The shadow and the decoration pre-composited into the strips above, left of, right of
+     * and below the client, so that they take one request per strip and frame.
+     **/
+    XRenderPicture m_frameStrips[FrameStripCount];
+    QRect m_frameStripRects[FrameStripCount];
+    QVector<QRect> m_frameLayout;
+    quint64 m_frameDecorationSerial = 0;
+    quint64 m_frameShadowSerial = 0;
     static QRect temp_visibleRect;
     static XRenderPicture *s_tempPicture;
     static XRenderPicture *s_fadeAlphaPicture;
@@ -306,12 +334,19 @@ public:
                            QRect& bottom, QRect& bottomLeft,
                            QRect& Left, QRect& topLeft);
     xcb_render_picture_t picture(ShadowElements element) const;
+    /**
+     * Changes whenever the pictures got recreated.
+     **/
+    quint64 serial() const {
+        return m_serial;
+    }
 
 protected:
     virtual void buildQuads();
     virtual bool prepareBackend();
 private:
     XRenderPicture* m_pictures[ShadowElementsCount];
+    quint64 m_serial = 0;
 };
 
 class SceneXRenderDecorationRenderer : public Decoration::Renderer
@@ -332,9 +367,16 @@ public:
     void reparent(Deleted *deleted) override;
 
     xcb_render_picture_t picture(DecorationPart part) const;
+    /**
+     * Changes whenever the content of the pictures changed.
+     **/
+    quint64 serial() const {
+        return m_serial;
+    }
 
 private:
     void resizePixmaps();
+    quint64 m_serial = 0;
     QSize m_sizes[int(DecorationPart::Count)];
     xcb_pixmap_t m_pixmaps[int(DecorationPart::Count)];
     xcb_gcontext_t m_gc;
@@ -19,6 +19,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 *********************************************************************/
 #include "pointer_input.h"
 #include "platform.h"
+#include "cursor.h"
 #include "effects.h"
 #include "input_event.h"
 #include "input_event_spy.h"
@@ -45,7 +46,10 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <KLocalizedString>
 
+#include <KConfigGroup>
+
 #include <QHoverEvent>
+#include <QTimer>
 #include <QWindow>
 // Wayland
 #include <wayland-cursor.h>
@@ -141,6 +145,14 @@ void PointerInputRedirection::init()
         );
     }
     connect(workspace(), &QObject::destroyed, this, [this] { m_inited = false; });
+
+    m_motionBatch.enabled = kwinApp()->config()->group("Wayland").readEntry("BatchPointerMotion", false);
+    if (m_motionBatch.enabled) {
+        m_motionBatch.timer = new QTimer(this);
+        m_motionBatch.timer->setSingleShot(true);
+        m_motionBatch.timer->setTimerType(Qt::PreciseTimer);
+        connect(m_motionBatch.timer, &QTimer::timeout, this, &PointerInputRedirection::flushPendingMotion);
+    }
     connect(waylandServer(), &QObject::destroyed, this, [this] { m_inited = false; });
     connect(waylandServer()->seat(), &KWayland::Server::SeatInterface::dragEnded, this,
         [this] {
@@ -263,11 +275,50 @@ private:
 int PositionUpdateBlocker::s_counter = 0;
 QVector<PositionUpdateBlocker::ScheduledPosition> PositionUpdateBlocker::s_scheduledPositions;
 
+void PointerInputRedirection::processRelativeMotion(const QSizeF &delta, const QSizeF &deltaNonAccelerated, uint32_t time, quint64 timeUsec, LibInput::Device *device)
+{
+    // while a pointer constraint is active the client most likely relies on the
+    // relative motion, so it gets each of the events
+    if (!m_inited || !m_motionBatch.enabled || m_locked || m_confined) {
+        // the constraint may have been activated while motion was batched, that motion
+        // has to move the pointer before the new position is derived from it
+        flushPendingMotion();
+        processMotion(m_pos + QPointF(delta.width(), delta.height()), delta, deltaNonAccelerated, time, timeUsec, device);
+        return;
+    }
+    if (!m_motionBatch.pending) {
+        m_motionBatch.pending = true;
+        m_motionBatch.delta = QSizeF(0, 0);
+        m_motionBatch.deltaNonAccelerated = QSizeF(0, 0);
+        const float refreshRate = screens()->refreshRate(screens()->number(m_pos.toPoint()));
+        m_motionBatch.timer->start(refreshRate > 0 ? qMax(1, qRound(1000.0 / refreshRate)) : 16);
+    }
+    m_motionBatch.delta += delta;
+    m_motionBatch.deltaNonAccelerated += deltaNonAccelerated;
+    m_motionBatch.time = time;
+    m_motionBatch.timeUsec = timeUsec;
+    m_motionBatch.device = device;
+}
+
+void PointerInputRedirection::flushPendingMotion()
+{
+    if (!m_motionBatch.pending) {
+        return;
+    }
+    m_motionBatch.pending = false;
+    m_motionBatch.timer->stop();
+    const QSizeF &delta = m_motionBatch.delta;
+    processMotion(m_pos + QPointF(delta.width(), delta.height()), delta, m_motionBatch.deltaNonAccelerated,
+                  m_motionBatch.time, m_motionBatch.timeUsec, m_motionBatch.device);
+}
+
 void PointerInputRedirection::processMotion(const QPointF &pos, const QSizeF &delta, const QSizeF &deltaNonAccelerated, uint32_t time, quint64 timeUsec, LibInput::Device *device)
 {
     if (!m_inited) {
         return;
     }
+    // keep the order of events, accumulated motion happened before this one
+    flushPendingMotion();
     if (PositionUpdateBlocker::isPositionBlocked()) {
         PositionUpdateBlocker::schedulePosition(pos, delta, deltaNonAccelerated, time, timeUsec);
         return;
@@ -281,11 +332,12 @@ void PointerInputRedirection::processMotion(const QPointF &pos, const QSizeF &de
     event.setModifiersRelevantForGlobalShortcuts(m_input->modifiersRelevantForGlobalShortcuts());
 
     m_input->processSpies(std::bind(&InputEventSpy::pointerEvent, std::placeholders::_1, &event));
-    m_input->processFilters(std::bind(&InputEventFilter::pointerEvent, std::placeholders::_1, &event, 0));
+    m_input->processFilters(InputEventFilter::EventType::Pointer, std::bind(&InputEventFilter::pointerEvent, std::placeholders::_1, &event, 0));
 }
 
 void PointerInputRedirection::processButton(uint32_t button, InputRedirection::PointerButtonState state, uint32_t time, LibInput::Device *device)
 {
+    flushPendingMotion();
     updateButton(button, state);
 
     QEvent::Type type;
@@ -312,11 +364,12 @@ void PointerInputRedirection::processButton(uint32_t button, InputRedirection::P
         return;
     }
 
-    m_input->processFilters(std::bind(&InputEventFilter::pointerEvent, std::placeholders::_1, &event, button));
+    m_input->processFilters(InputEventFilter::EventType::Pointer, std::bind(&InputEventFilter::pointerEvent, std::placeholders::_1, &event, button));
 }
 
 void PointerInputRedirection::processAxis(InputRedirection::PointerAxis axis, qreal delta, uint32_t time, LibInput::Device *device)
 {
+    flushPendingMotion();
     if (delta == 0) {
         return;
     }
@@ -333,7 +386,7 @@ void PointerInputRedirection::processAxis(InputRedirection::PointerAxis axis, qr
     if (!m_inited) {
         return;
     }
-    m_input->processFilters(std::bind(&InputEventFilter::wheelEvent, std::placeholders::_1, &wheelEvent));
+    m_input->processFilters(InputEventFilter::EventType::Wheel, std::bind(&InputEventFilter::wheelEvent, std::placeholders::_1, &wheelEvent));
 }
 
 void PointerInputRedirection::processSwipeGestureBegin(int fingerCount, quint32 time, KWin::LibInput::Device *device)
@@ -342,9 +395,10 @@ void PointerInputRedirection::processSwipeGestureBegin(int fingerCount, quint32
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::swipeGestureBegin, std::placeholders::_1, fingerCount, time));
-    m_input->processFilters(std::bind(&InputEventFilter::swipeGestureBegin, std::placeholders::_1, fingerCount, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::swipeGestureBegin, std::placeholders::_1, fingerCount, time));
 }
 
 void PointerInputRedirection::processSwipeGestureUpdate(const QSizeF &delta, quint32 time, KWin::LibInput::Device *device)
@@ -353,9 +407,10 @@ void PointerInputRedirection::processSwipeGestureUpdate(const QSizeF &delta, qui
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::swipeGestureUpdate, std::placeholders::_1, delta, time));
-    m_input->processFilters(std::bind(&InputEventFilter::swipeGestureUpdate, std::placeholders::_1, delta, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::swipeGestureUpdate, std::placeholders::_1, delta, time));
 }
 
 void PointerInputRedirection::processSwipeGestureEnd(quint32 time, KWin::LibInput::Device *device)
@@ -364,9 +419,10 @@ void PointerInputRedirection::processSwipeGestureEnd(quint32 time, KWin::LibInpu
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::swipeGestureEnd, std::placeholders::_1, time));
-    m_input->processFilters(std::bind(&InputEventFilter::swipeGestureEnd, std::placeholders::_1, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::swipeGestureEnd, std::placeholders::_1, time));
 }
 
 void PointerInputRedirection::processSwipeGestureCancelled(quint32 time, KWin::LibInput::Device *device)
@@ -375,9 +431,10 @@ void PointerInputRedirection::processSwipeGestureCancelled(quint32 time, KWin::L
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::swipeGestureCancelled, std::placeholders::_1, time));
-    m_input->processFilters(std::bind(&InputEventFilter::swipeGestureCancelled, std::placeholders::_1, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::swipeGestureCancelled, std::placeholders::_1, time));
 }
 
 void PointerInputRedirection::processPinchGestureBegin(int fingerCount, quint32 time, KWin::LibInput::Device *device)
@@ -386,9 +443,10 @@ void PointerInputRedirection::processPinchGestureBegin(int fingerCount, quint32
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::pinchGestureBegin, std::placeholders::_1, fingerCount, time));
-    m_input->processFilters(std::bind(&InputEventFilter::pinchGestureBegin, std::placeholders::_1, fingerCount, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::pinchGestureBegin, std::placeholders::_1, fingerCount, time));
 }
 
 void PointerInputRedirection::processPinchGestureUpdate(qreal scale, qreal angleDelta, const QSizeF &delta, quint32 time, KWin::LibInput::Device *device)
@@ -397,9 +455,10 @@ void PointerInputRedirection::processPinchGestureUpdate(qreal scale, qreal angle
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::pinchGestureUpdate, std::placeholders::_1, scale, angleDelta, delta, time));
-    m_input->processFilters(std::bind(&InputEventFilter::pinchGestureUpdate, std::placeholders::_1, scale, angleDelta, delta, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::pinchGestureUpdate, std::placeholders::_1, scale, angleDelta, delta, time));
 }
 
 void PointerInputRedirection::processPinchGestureEnd(quint32 time, KWin::LibInput::Device *device)
@@ -408,9 +467,10 @@ void PointerInputRedirection::processPinchGestureEnd(quint32 time, KWin::LibInpu
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::pinchGestureEnd, std::placeholders::_1, time));
-    m_input->processFilters(std::bind(&InputEventFilter::pinchGestureEnd, std::placeholders::_1, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::pinchGestureEnd, std::placeholders::_1, time));
 }
 
 void PointerInputRedirection::processPinchGestureCancelled(quint32 time, KWin::LibInput::Device *device)
@@ -419,9 +479,10 @@ void PointerInputRedirection::processPinchGestureCancelled(quint32 time, KWin::L
     if (!m_inited) {
         return;
     }
+    flushPendingMotion();
 
     m_input->processSpies(std::bind(&InputEventSpy::pinchGestureCancelled, std::placeholders::_1, time));
-    m_input->processFilters(std::bind(&InputEventFilter::pinchGestureCancelled, std::placeholders::_1, time));
+    m_input->processFilters(InputEventFilter::EventType::Gesture, std::bind(&InputEventFilter::pinchGestureCancelled, std::placeholders::_1, time));
 }
 
 void PointerInputRedirection::update()
@@ -880,17 +941,23 @@ CursorImage::CursorImage(PointerInputRedirection *parent)
     std::for_each(clients.begin(), clients.end(), setupMoveResizeConnection);
     connect(workspace(), &Workspace::clientAdded, this, setupMoveResizeConnection);
     connect(waylandServer(), &WaylandServer::shellClientAdded, this, setupMoveResizeConnection);
-    loadThemeCursor(Qt::ArrowCursor, &m_fallbackCursor);
+    loadTheme();
     if (m_cursorTheme) {
         connect(m_cursorTheme, &WaylandCursorTheme::themeChanged, this,
             [this] {
                 m_cursors.clear();
+                preloadThemeCursors();
                 loadThemeCursor(Qt::ArrowCursor, &m_fallbackCursor);
                 updateDecorationCursor();
                 updateMoveResize();
+                if (m_currentSource == CursorSource::Fallback) {
+                    emit changed();
+                }
                 // TODO: update effects
             }
         );
+        // the theme files are read in a thread, the fallback cursor gets loaded once that finished
+        m_cursorTheme->preload();
     }
     m_surfaceRenderedTimer.start();
 }
@@ -993,6 +1060,42 @@ void CursorImage::updateMoveResize()
     reevaluteSource();
 }
 
+static bool sameImageContent(const QImage &a, const QImage &b)
+{
+    if (a.size() != b.size() || a.format() != b.format()) {
+        return false;
+    }
+    const int bytes = a.width() * a.depth() / 8;
+    for (int y = 0; y < a.height(); ++y) {
+        if (memcmp(a.constScanLine(y), b.constScanLine(y), bytes) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+QImage CursorImage::cachedCursorImage(KWayland::Server::BufferInterface *buffer)
+{
+    // comparing is cheaper than a copy and keeps the QImage, thus its cacheKey,
+    // stable, which allows the platform to skip uploading an unchanged cursor
+    const QImage data = buffer->data();
+    auto it = m_serverCursor.cache.find(buffer);
+    if (it != m_serverCursor.cache.end()) {
+        if (!sameImageContent(it.value(), data)) {
+            it.value() = data.copy();
+        }
+        return it.value();
+    }
+    const QImage image = data.copy();
+    m_serverCursor.cache.insert(buffer, image);
+    connect(buffer, &QObject::destroyed, this,
+        [this, buffer] {
+            m_serverCursor.cache.remove(buffer);
+        }
+    );
+    return image;
+}
+
 void CursorImage::updateServerCursor()
 {
     m_serverCursor.image = QImage();
@@ -1028,7 +1131,7 @@ void CursorImage::updateServerCursor()
         return;
     }
     m_serverCursor.hotSpot = c->hotspot();
-    m_serverCursor.image = buffer->data().copy();
+    m_serverCursor.image = cachedCursorImage(buffer);
     if (needsEmit) {
         emit changed();
     }
@@ -1149,45 +1252,80 @@ void CursorImage::updateDragCursor()
 
 void CursorImage::loadThemeCursor(Qt::CursorShape shape, Image *image)
 {
-    loadThemeCursor(shape, m_cursors, image);
+    loadThemeCursor(Cursor::self()->cursorName(shape), image);
 }
 
-void CursorImage::loadThemeCursor(const QByteArray &shape, Image *image)
+static QImage themeCursorImage(wl_cursor_image *cursor)
 {
-    loadThemeCursor(shape, m_cursorsByName, image);
+    wl_buffer *b = wl_cursor_image_get_buffer(cursor);
+    if (!b) {
+        return QImage();
+    }
+    auto buffer = KWayland::Server::BufferInterface::get(waylandServer()->internalConnection()->getResource(KWayland::Client::Buffer::getId(b)));
+    if (!buffer) {
+        return QImage();
+    }
+    return buffer->data().copy();
 }
 
-template <typename T>
-void CursorImage::loadThemeCursor(const T &shape, QHash<T, Image> &cursors, Image *image)
+void CursorImage::loadThemeCursor(const QByteArray &shape, Image *image)
 {
     loadTheme();
     if (!m_cursorTheme) {
         return;
     }
-    auto it = cursors.constFind(shape);
-    if (it == cursors.constEnd()) {
+    auto it = m_cursors.constFind(shape);
+    if (it == m_cursors.constEnd()) {
         image->image = QImage();
         image->hotSpot = QPoint();
         wl_cursor_image *cursor = m_cursorTheme->get(shape);
-        if (!cursor) {
-            return;
-        }
-        wl_buffer *b = wl_cursor_image_get_buffer(cursor);
-        if (!b) {
+        if (!cursor || !wl_cursor_image_get_buffer(cursor)) {
             return;
         }
         waylandServer()->internalClientConection()->flush();
         waylandServer()->dispatch();
-        auto buffer = KWayland::Server::BufferInterface::get(waylandServer()->internalConnection()->getResource(KWayland::Client::Buffer::getId(b)));
-        if (!buffer) {
+        const QImage cursorImage = themeCursorImage(cursor);
+        if (cursorImage.isNull()) {
             return;
         }
-        it = decltype(it)(cursors.insert(shape, {buffer->data().copy(), QPoint(cursor->hotspot_x, cursor->hotspot_y)}));
+        it = m_cursors.insert(shape, {cursorImage, QPoint(cursor->hotspot_x, cursor->hotspot_y)});
     }
     image->hotSpot = it.value().hotSpot;
     image->image = it.value().image;
 }
 
+void CursorImage::preloadThemeCursors()
+{
+    if (!m_cursorTheme) {
+        return;
+    }
+    // create the buffers of all standard shapes first, so that they arrive with a single dispatch
+    QVector<QPair<QByteArray, wl_cursor_image*>> cursors;
+    for (int i = Qt::ArrowCursor; i <= Qt::LastCursor; ++i) {
+        const QByteArray name = Cursor::self()->cursorName(Qt::CursorShape(i));
+        if (name.isEmpty() || m_cursors.contains(name)) {
+            continue;
+        }
+        wl_cursor_image *cursor = m_cursorTheme->get(name);
+        if (!cursor || !wl_cursor_image_get_buffer(cursor)) {
+            continue;
+        }
+        cursors << qMakePair(name, cursor);
+    }
+    if (cursors.isEmpty()) {
+        return;
+    }
+    waylandServer()->internalClientConection()->flush();
+    waylandServer()->dispatch();
+    for (const auto &cursor : cursors) {
+        const QImage image = themeCursorImage(cursor.second);
+        if (image.isNull()) {
+            continue;
+        }
+        m_cursors.insert(cursor.first, {image, QPoint(cursor.second->hotspot_x, cursor.second->hotspot_y)});
+    }
+}
+
 void CursorImage::reevaluteSource()
 {
     if (waylandServer()->seat()->isDragPointer()) {
@@ -27,12 +27,14 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <QPointer>
 #include <QPointF>
 
+class QTimer;
 class QWindow;
 
 namespace KWayland
 {
 namespace Server
 {
+class BufferInterface;
 class SurfaceInterface;
 }
 }
@@ -102,6 +104,23 @@ public:
      * @internal
      **/
     void processMotion(const QPointF &pos, const QSizeF &delta, const QSizeF &deltaNonAccelerated, uint32_t time, quint64 timeUsec, LibInput::Device *device);
+    /**
+     * Relative motion by @p delta from the current position.
+     *
+     * If motion batching is enabled the motion is accumulated and processed once
+     * per refresh cycle of the screen the pointer is on. Any other pointer event
+     * processes the accumulated motion first.
+     * @internal
+     **/
+    void processRelativeMotion(const QSizeF &delta, const QSizeF &deltaNonAccelerated, uint32_t time, quint64 timeUsec, LibInput::Device *device);
+    /**
+     * Processes the relative motion accumulated by processRelativeMotion, if any.
+     *
+     * Needs to be invoked before any other input event gets processed to keep the order of
+     * events and before the device of the accumulated motion gets destroyed.
+     * @internal
+     **/
+    void flushPendingMotion();
     /**
      * @internal
      */
@@ -166,6 +185,16 @@ private:
     bool m_confined = false;
     bool m_locked = false;
     bool m_blockConstraint = false;
+    struct {
+        bool enabled = false;
+        bool pending = false;
+        QSizeF delta;
+        QSizeF deltaNonAccelerated;
+        quint32 time = 0;
+        quint64 timeUsec = 0;
+        LibInput::Device *device = nullptr;
+        QTimer *timer = nullptr;
+    } m_motionBatch;
 };
 
 class CursorImage : public QObject
@@ -191,6 +220,7 @@ private:
     void reevaluteSource();
     void update();
     void updateServerCursor();
+    QImage cachedCursorImage(KWayland::Server::BufferInterface *buffer);
     void updateDecoration();
     void updateDecorationCursor();
     void updateMoveResize();
@@ -203,8 +233,7 @@ private:
     };
     void loadThemeCursor(Qt::CursorShape shape, Image *image);
     void loadThemeCursor(const QByteArray &shape, Image *image);
-    template <typename T>
-    void loadThemeCursor(const T &shape, QHash<T, Image> &cursors, Image *image);
+    void preloadThemeCursors();
 
     enum class CursorSource {
         LockScreen,
@@ -225,6 +254,11 @@ private:
         QMetaObject::Connection connection;
         QImage image;
         QPoint hotSpot;
+        /**
+         * The images of the cursor buffers seen so far. Clients usually cycle through
+         * the same buffers, e.g. for animated cursors, so the image can be reused.
+         **/
+        QHash<KWayland::Server::BufferInterface*, QImage> cache;
     } m_serverCursor;
 
     Image m_effectsCursor;
@@ -233,8 +267,10 @@ private:
     Image m_fallbackCursor;
     Image m_moveResizeCursor;
     Image m_windowSelectionCursor;
-    QHash<Qt::CursorShape, Image> m_cursors;
-    QHash<QByteArray, Image> m_cursorsByName;
+    /**
+     * The images of the theme cursors by their name, shared by all cursor sources.
+     **/
+    QHash<QByteArray, Image> m_cursors;
     QElapsedTimer m_surfaceRenderedTimer;
     struct {
         Image cursor;
@@ -185,6 +185,33 @@ void Scene::updateTimeDiff()
         time_diff = 1;
 }
 
+void Scene::beginMultiOutputFrame()
+{
+    m_multiOutputFrame = true;
+    for (Window *w : stacking_order) {
+        Toplevel *topw = w->window();
+        m_frameRepaints.insert(w, topw->repaints());
+        topw->resetRepaints();
+    }
+}
+
+void Scene::endMultiOutputFrame()
+{
+    m_multiOutputFrame = false;
+    m_frameRepaints.clear();
+}
+
+QRegion Scene::takeRepaints(Window *w)
+{
+    if (m_multiOutputFrame) {
+        return m_frameRepaints.value(w);
+    }
+    Toplevel *topw = w->window();
+    const QRegion repaints = topw->repaints();
+    topw->resetRepaints();
+    return repaints;
+}
+
 // Painting pass is optimized away.
 void Scene::idle()
 {
@@ -210,12 +237,10 @@ void Scene::paintGenericScreen(int orig_mask, ScreenPaintData)
     }
     QList< Phase2Data > phase2;
     foreach (Window * w, stacking_order) { // bottom to top
-        Toplevel* topw = w->window();
-
         // Reset the repaint_region.
         // This has to be done here because many effects schedule a repaint for
         // the next frame within Effects::prePaintWindow.
-        topw->resetRepaints();
+        takeRepaints(w);
 
         WindowPrePaintData data;
         data.mask = orig_mask | (w->isOpaque() ? PAINT_WINDOW_OPAQUE : PAINT_WINDOW_TRANSLUCENT);
@@ -264,12 +289,10 @@ void Scene::paintSimpleScreen(int orig_mask, QRegion region)
         data.mask = orig_mask | (w->isOpaque() ? PAINT_WINDOW_OPAQUE : PAINT_WINDOW_TRANSLUCENT);
         w->resetPaintingEnabled();
         data.paint = region;
-        data.paint |= topw->repaints();
-
         // Reset the repaint_region.
         // This has to be done here because many effects schedule a repaint for
         // the next frame within Effects::prePaintWindow.
-        topw->resetRepaints();
+        data.paint |= takeRepaints(w);
 
         // Clip out the decoration for opaque windows; the decoration is drawn in the second pass
         opaqueFullscreen = false; // TODO: do we care about unmanged windows here (maybe input windows?)
@@ -728,6 +751,23 @@ void Scene::Window::pixmapDiscarded()
     }
 }
 
+void Scene::Window::releaseHiddenPixmaps()
+{
+    // effects might still paint the previous pixmap of a closed window
+    if (m_referencePixmapCounter != 0) {
+        return;
+    }
+    // an unmapped window cannot get a new pixmap, only one kept mapped for
+    // previews can be recreated
+    Client *c = qobject_cast<Client*>(toplevel);
+    if (!c || !c->hiddenPreview()) {
+        return;
+    }
+    // the pixmaps get created again once the window is painted
+    m_currentPixmap.reset();
+    m_previousPixmap.reset();
+}
+
 void Scene::Window::discardShape()
 {
     // it is created on-demand and cached, simply
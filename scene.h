@@ -226,6 +226,17 @@ protected:
     virtual void paintDesktop(int desktop, int mask, const QRegion &region, ScreenPaintData &data);
     // compute time since the last repaint
     void updateTimeDiff();
+    /**
+     * Starts a frame which gets rendered with one paintScreen() call per output. The repaints
+     * of all windows are taken up front, so that every output gets them and not just the first.
+     * Needs to be called after createStackingOrder().
+     **/
+    void beginMultiOutputFrame();
+    void endMultiOutputFrame();
+    /**
+     * Takes the repaints of @p w for the current paintScreen() pass.
+     **/
+    QRegion takeRepaints(Window *w);
     // saved data for 2nd pass of optimized screen painting
     struct Phase2Data {
         Phase2Data(Window* w, QRegion r, QRegion c, int m, const WindowQuadList& q)
@@ -259,6 +270,9 @@ private:
     QHash< Toplevel*, Window* > m_windows;
     // windows in their stacking order
     QVector< Window* > stacking_order;
+    // repaints of the windows, taken for all outputs of the current frame
+    QHash< Window*, QRegion > m_frameRepaints;
+    bool m_multiOutputFrame = false;
 };
 
 /**
@@ -289,6 +303,8 @@ public:
     virtual void performPaint(int mask, QRegion region, WindowPaintData data) = 0;
     // do any cleanup needed when the window's composite pixmap is discarded
     void pixmapDiscarded();
+    // frees the pixmaps of a window which is only kept mapped for previews to save texture memory
+    void releaseHiddenPixmaps();
     int x() const;
     int y() const;
     int width() const;
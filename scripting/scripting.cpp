@@ -450,7 +450,7 @@ KWin::Script::Script(int id, QString scriptName, QString pluginName, QObject* pa
     : AbstractScript(id, scriptName, pluginName, parent)
     , m_engine(new QScriptEngine(this))
     , m_starting(false)
-    , m_agent(new ScriptUnloaderAgent(this))
+    , m_agent(new ScriptAgent(this))
 {
     QDBusConnection::sessionBus().registerObject(QLatin1Char('/') + QString::number(scriptId()), this, QDBusConnection::ExportScriptableContents | QDBusConnection::ExportScriptableInvokables);
 }
@@ -560,19 +560,79 @@ bool KWin::Script::unregisterTouchScreenCallback(int edge)
     return true;
 }
 
-KWin::ScriptUnloaderAgent::ScriptUnloaderAgent(KWin::Script *script)
+void KWin::Script::callbackFinished(qint64 nsecs)
+{
+    if (!running()) {
+        // initial evaluation of the script, not a callback
+        return;
+    }
+    ++m_callbackCount;
+    m_callbackTime += nsecs;
+    m_longestCallbackTime = qMax(m_longestCallbackTime, nsecs);
+    const int milliseconds = nsecs / 1000000;
+    const int budget = options->scriptCallbackTimeBudget();
+    if (budget > 0 && milliseconds >= budget) {
+        ++m_slowCallbackCount;
+        qCDebug(KWIN_SCRIPTING) << fileName() << ": callback took" << milliseconds << "ms, the budget is" << budget << "ms";
+        emit callbackBudgetExceeded(milliseconds);
+    }
+}
+
+qlonglong KWin::Script::callbackCount() const
+{
+    return m_callbackCount;
+}
+
+qlonglong KWin::Script::slowCallbackCount() const
+{
+    return m_slowCallbackCount;
+}
+
+qlonglong KWin::Script::totalCallbackTime() const
+{
+    return m_callbackTime / 1000000;
+}
+
+int KWin::Script::longestCallbackTime() const
+{
+    return m_longestCallbackTime / 1000000;
+}
+
+KWin::ScriptAgent::ScriptAgent(KWin::Script *script)
     : QScriptEngineAgent(script->engine())
     , m_script(script)
 {
     script->engine()->setAgent(this);
 }
 
-void KWin::ScriptUnloaderAgent::scriptUnload(qint64 id)
+void KWin::ScriptAgent::scriptUnload(qint64 id)
 {
     Q_UNUSED(id)
     m_script->stop();
 }
 
+void KWin::ScriptAgent::functionEntry(qint64 scriptId)
+{
+    Q_UNUSED(scriptId)
+    // only the outermost call is a callback from KWin into the script
+    if (m_depth++ == 0) {
+        m_callbackTimer.start();
+    }
+}
+
+void KWin::ScriptAgent::functionExit(qint64 scriptId, const QScriptValue &returnValue)
+{
+    Q_UNUSED(scriptId)
+    Q_UNUSED(returnValue)
+    if (m_depth == 0) {
+        // unbalanced exit, e.g. the agent got installed while the script was running
+        return;
+    }
+    if (--m_depth == 0) {
+        m_script->callbackFinished(m_callbackTimer.nsecsElapsed());
+    }
+}
+
 KWin::DeclarativeScript::DeclarativeScript(int id, QString scriptName, QString pluginName, QObject* parent)
     : AbstractScript(id, scriptName, pluginName, parent)
     , m_context(new QQmlContext(Scripting::self()->declarativeScriptSharedContext(), this))
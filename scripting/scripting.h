@@ -24,6 +24,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <kwinglobals.h>
 
+#include <QElapsedTimer>
 #include <QFile>
 #include <QHash>
 #include <QStringList>
@@ -50,7 +51,7 @@ namespace KWin
 {
 class AbstractClient;
 class Client;
-class ScriptUnloaderAgent;
+class ScriptAgent;
 class QtScriptWorkspaceWrapper;
 
 class KWIN_EXPORT AbstractScript : public QObject
@@ -234,9 +235,32 @@ public:
 
 public Q_SLOTS:
     Q_SCRIPTABLE void run();
+    /**
+     * @returns The number of callbacks (signal handlers, timers, shortcuts, etc.) which
+     * were invoked since the script got started.
+     **/
+    Q_SCRIPTABLE qlonglong callbackCount() const;
+    /**
+     * @returns The number of callbacks which took longer than the configured time budget.
+     **/
+    Q_SCRIPTABLE qlonglong slowCallbackCount() const;
+    /**
+     * @returns The accumulated time in milliseconds spent in callbacks of the script.
+     **/
+    Q_SCRIPTABLE qlonglong totalCallbackTime() const;
+    /**
+     * @returns The duration in milliseconds of the longest callback invocation.
+     **/
+    Q_SCRIPTABLE int longestCallbackTime() const;
 
 Q_SIGNALS:
     Q_SCRIPTABLE void printError(const QString &text);
+    /**
+     * Emitted whenever a callback of the script took longer than the time budget
+     * configured in Options::scriptCallbackTimeBudget.
+     * @param milliseconds The time the callback took
+     **/
+    Q_SCRIPTABLE void callbackBudgetExceeded(int milliseconds);
 
 private Q_SLOTS:
     /**
@@ -256,20 +280,37 @@ private:
      * If file cannot be read an empty byte array is returned.
      **/
     QByteArray loadScriptFromFile();
+    /**
+     * Invoked by the ScriptAgent whenever control returns from the script to KWin.
+     **/
+    void callbackFinished(qint64 nsecs);
     QScriptEngine *m_engine;
     bool m_starting;
-    QScopedPointer<ScriptUnloaderAgent> m_agent;
+    QScopedPointer<ScriptAgent> m_agent;
     QHash<int, QAction*> m_touchScreenEdgeCallbacks;
+    qlonglong m_callbackCount = 0;
+    qlonglong m_slowCallbackCount = 0;
+    qint64 m_callbackTime = 0;
+    qint64 m_longestCallbackTime = 0;
+    friend class ScriptAgent;
 };
 
-class ScriptUnloaderAgent : public QScriptEngineAgent
+/**
+ * The agent stops the Script when the engine unloads it and measures the time
+ * spent in each callback, that is each call from KWin into the script.
+ **/
+class ScriptAgent : public QScriptEngineAgent
 {
 public:
-    explicit ScriptUnloaderAgent(Script *script);
-    virtual void scriptUnload(qint64 id);
+    explicit ScriptAgent(Script *script);
+    void scriptUnload(qint64 id) override;
+    void functionEntry(qint64 scriptId) override;
+    void functionExit(qint64 scriptId, const QScriptValue &returnValue) override;
 
 private:
     Script *m_script;
+    int m_depth = 0;
+    QElapsedTimer m_callbackTimer;
 };
 
 class DeclarativeScript : public AbstractScript
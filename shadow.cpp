@@ -75,7 +75,7 @@ Shadow *Shadow::createShadow(Toplevel *toplevel)
 
 Shadow *Shadow::createShadowFromX11(Toplevel *toplevel)
 {
-    auto data = Shadow::readX11ShadowProperty(toplevel->window());
+    auto data = Shadow::readX11ShadowProperty(toplevel);
     if (!data.isEmpty()) {
         Shadow *shadow = Compositor::self()->scene()->createShadow(toplevel);
 
@@ -124,17 +124,15 @@ Shadow *Shadow::createShadowFromWayland(Toplevel *toplevel)
     return shadow;
 }
 
-QVector< uint32_t > Shadow::readX11ShadowProperty(xcb_window_t id)
+QVector< uint32_t > Shadow::readX11ShadowProperty(Toplevel *toplevel)
 {
     QVector<uint32_t> ret;
-    if (id != XCB_WINDOW) {
-        Xcb::Property property(false, id, atoms->kde_net_wm_shadow, XCB_ATOM_CARDINAL, 0, 12);
-        uint32_t *shadow = property.value<uint32_t*>();
-        if (shadow) {
-            ret.reserve(12);
-            for (int i=0; i<12; ++i) {
-                ret << shadow[i];
-            }
+    const QByteArray property = toplevel->readProperty(atoms->kde_net_wm_shadow, XCB_ATOM_CARDINAL, 32);
+    if (property.size() >= int(12 * sizeof(uint32_t))) {
+        const uint32_t *shadow = reinterpret_cast<const uint32_t*>(property.constData());
+        ret.reserve(12);
+        for (int i=0; i<12; ++i) {
+            ret << shadow[i];
         }
     }
     return ret;
@@ -372,7 +370,7 @@ bool Shadow::updateShadow()
         clear();
         return false;
     }
-    auto data = Shadow::readX11ShadowProperty(m_topLevel->window());
+    auto data = Shadow::readX11ShadowProperty(m_topLevel);
     if (data.isEmpty()) {
         clear();
         return false;
@@ -169,7 +169,7 @@ private:
     static Shadow *createShadowFromX11(Toplevel *toplevel);
     static Shadow *crateShadowFromDecoration(Toplevel *toplevel);
     static Shadow *createShadowFromWayland(Toplevel *toplevel);
-    static QVector<uint32_t> readX11ShadowProperty(xcb_window_t id);
+    static QVector<uint32_t> readX11ShadowProperty(Toplevel *toplevel);
     bool init(const QVector<uint32_t> &data);
     bool init(KDecoration2::Decoration *decoration);
     bool init(const QPointer<KWayland::Server::ShadowInterface> &shadow);
@@ -227,7 +227,6 @@ void Workspace::addSessionInfo(KConfigGroup &cg)
     for (int i = 1; i <= count; i++) {
         QString n = QString::number(i);
         SessionInfo* info = new SessionInfo;
-        session.append(info);
         info->sessionId = cg.readEntry(QLatin1String("sessionId") + n, QString()).toLatin1();
         info->windowRole = cg.readEntry(QLatin1String("windowRole") + n, QString()).toLatin1();
         info->wmCommand = cg.readEntry(QLatin1String("wmCommand") + n, QString()).toLatin1();
@@ -256,6 +255,7 @@ void Workspace::addSessionInfo(KConfigGroup &cg)
         info->tabGroup = cg.readEntry(QLatin1String("tabGroup") + n, 0);
         info->tabGroupClient = NULL;
         info->activities = cg.readEntry(QLatin1String("activities") + n, QStringList());
+        session.add(info);
     }
 }
 
@@ -286,45 +286,40 @@ SessionInfo* Workspace::takeSessionInfo(Client* c)
     // First search ``session''
     if (! sessionId.isEmpty()) {
         // look for a real session managed client (algorithm suggested by ICCCM)
-        foreach (SessionInfo * info, session) {
-            if (realInfo)
-                break;
-            if (info->sessionId == sessionId && sessionInfoWindowTypeMatch(c, info)) {
-                if (! windowRole.isEmpty()) {
-                    if (info->windowRole == windowRole) {
-                        realInfo = info;
-                        session.removeAll(info);
-                    }
-                } else {
-                    if (info->windowRole.isEmpty()
-                            && info->resourceName == resourceName
-                            && info->resourceClass == resourceClass) {
-                        realInfo = info;
-                        session.removeAll(info);
-                    }
-                }
+        const auto candidates = session.bySessionId(sessionId, windowRole);
+        for (SessionInfo *info : candidates) {
+            if (!sessionInfoWindowTypeMatch(c, info)) {
+                continue;
+            }
+            if (windowRole.isEmpty()
+                    && (info->resourceName != resourceName || info->resourceClass != resourceClass)) {
+                continue;
             }
+            realInfo = info;
+            break;
         }
     } else {
         // look for a sessioninfo with matching features.
-        foreach (SessionInfo * info, session) {
-            if (realInfo)
+        const auto candidates = session.byClass(resourceName, resourceClass);
+        for (SessionInfo *info : candidates) {
+            if (!sessionInfoWindowTypeMatch(c, info)) {
+                continue;
+            }
+            if (wmCommand.isEmpty() || info->wmCommand == wmCommand) {
+                realInfo = info;
                 break;
-            if (info->resourceName == resourceName
-                    && info->resourceClass == resourceClass
-                    && sessionInfoWindowTypeMatch(c, info)) {
-                if (wmCommand.isEmpty() || info->wmCommand == wmCommand) {
-                    realInfo = info;
-                    session.removeAll(info);
-                }
             }
         }
     }
+    if (realInfo) {
+        session.take(realInfo);
+    }
 
     // Set tabGroupClient for other clients in the same group
     if (realInfo && realInfo->tabGroup) {
-        foreach (SessionInfo * info, session) {
-            if (!info->tabGroupClient && info->tabGroup == realInfo->tabGroup)
+        const auto group = session.byTabGroup(realInfo->tabGroup);
+        for (SessionInfo *info : group) {
+            if (!info->tabGroupClient)
                 info->tabGroupClient = c;
         }
     }
@@ -332,6 +327,53 @@ SessionInfo* Workspace::takeSessionInfo(Client* c)
     return realInfo;
 }
 
+SessionInfoStore::~SessionInfoStore()
+{
+    clear();
+}
+
+void SessionInfoStore::add(SessionInfo *info)
+{
+    m_bySessionId[qMakePair(info->sessionId, info->windowRole)].append(info);
+    m_byClass[qMakePair(info->resourceName, info->resourceClass)].append(info);
+    if (info->tabGroup) {
+        m_byTabGroup[info->tabGroup].append(info);
+    }
+}
+
+template <typename Key>
+static void removeFromIndex(QHash<Key, QList<SessionInfo*>> &index, const Key &key, SessionInfo *info)
+{
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return;
+    }
+    it.value().removeOne(info);
+    if (it.value().isEmpty()) {
+        index.erase(it);
+    }
+}
+
+void SessionInfoStore::take(SessionInfo *info)
+{
+    removeFromIndex(m_bySessionId, qMakePair(info->sessionId, info->windowRole), info);
+    removeFromIndex(m_byClass, qMakePair(info->resourceName, info->resourceClass), info);
+    if (info->tabGroup) {
+        removeFromIndex(m_byTabGroup, info->tabGroup, info);
+    }
+}
+
+void SessionInfoStore::clear()
+{
+    // every SessionInfo is in the class index exactly once
+    for (auto it = m_byClass.constBegin(); it != m_byClass.constEnd(); ++it) {
+        qDeleteAll(it.value());
+    }
+    m_bySessionId.clear();
+    m_byClass.clear();
+    m_byTabGroup.clear();
+}
+
 bool Workspace::sessionInfoWindowTypeMatch(Client* c, SessionInfo* info)
 {
     if (info->windowType == -2) {
@@ -24,6 +24,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 #include <QDataStream>
 #include <kwinglobals.h>
+#include <QHash>
+#include <QPair>
 #include <QStringList>
 #include <netwm_def.h>
 #include <QRect>
@@ -72,6 +74,50 @@ struct SessionInfo {
     QStringList activities;
 };
 
+/**
+ * Owns the SessionInfos read from the session config and indexes them by
+ * session id plus window role, by window class and by tab group, so that
+ * matching a newly managed client does not need to walk all of them.
+ **/
+class SessionInfoStore
+{
+public:
+    SessionInfoStore() = default;
+    ~SessionInfoStore();
+
+    void add(SessionInfo *info);
+    /**
+     * Removes @p info from the store, the caller takes over ownership.
+     **/
+    void take(SessionInfo *info);
+    /**
+     * Deletes all SessionInfos still in the store.
+     **/
+    void clear();
+
+    /**
+     * @returns the SessionInfos with @p sessionId and @p windowRole, in the order they got added
+     **/
+    QList<SessionInfo*> bySessionId(const QByteArray &sessionId, const QByteArray &windowRole) const {
+        return m_bySessionId.value(qMakePair(sessionId, windowRole));
+    }
+    /**
+     * @returns the SessionInfos with @p resourceName and @p resourceClass, in the order they got added
+     **/
+    QList<SessionInfo*> byClass(const QByteArray &resourceName, const QByteArray &resourceClass) const {
+        return m_byClass.value(qMakePair(resourceName, resourceClass));
+    }
+    QList<SessionInfo*> byTabGroup(int tabGroup) const {
+        return m_byTabGroup.value(tabGroup);
+    }
+
+private:
+    Q_DISABLE_COPY(SessionInfoStore)
+    QHash<QPair<QByteArray, QByteArray>, QList<SessionInfo*>> m_bySessionId;
+    QHash<QPair<QByteArray, QByteArray>, QList<SessionInfo*>> m_byClass;
+    QHash<int, QList<SessionInfo*>> m_byTabGroup;
+};
+
 
 enum SMSavePhase {
     SMSavePhase0,     // saving global state in "phase 0"
@@ -169,7 +169,7 @@ void ClientModel::createClientList(int desktop, bool partialReset)
         }
     }
 
-    m_clientList.clear();
+    TabBoxClientList clientList;
     QList< QWeakPointer< TabBoxClient > > stickyClients;
 
     switch(tabBox->config().clientSwitchingMode()) {
@@ -185,7 +185,7 @@ void ClientModel::createClientList(int desktop, bool partialReset)
         do {
             QWeakPointer<TabBoxClient> add = tabBox->clientToAddToList(c, desktop);
             if (!add.isNull()) {
-                m_clientList += add;
+                clientList += add;
                 if (add.data()->isFirstInTabBox()) {
                     stickyClients << add;
                 }
@@ -204,10 +204,10 @@ void ClientModel::createClientList(int desktop, bool partialReset)
             QWeakPointer<TabBoxClient> add = tabBox->clientToAddToList(c, desktop);
             if (!add.isNull()) {
                 if (start == add.data()) {
-                    m_clientList.removeAll(add);
-                    m_clientList.prepend(add);
+                    clientList.removeAll(add);
+                    clientList.prepend(add);
                 } else
-                    m_clientList += add;
+                    clientList += add;
                 if (add.data()->isFirstInTabBox()) {
                     stickyClients << add;
                 }
@@ -225,15 +225,54 @@ void ClientModel::createClientList(int desktop, bool partialReset)
     }
     }
     foreach (const QWeakPointer< TabBoxClient > &c, stickyClients) {
-        m_clientList.removeAll(c);
-        m_clientList.prepend(c);
+        clientList.removeAll(c);
+        clientList.prepend(c);
     }
-    if (tabBox->config().showDesktopMode() == TabBoxConfig::ShowDesktopClient || m_clientList.isEmpty()) {
+    if (tabBox->config().showDesktopMode() == TabBoxConfig::ShowDesktopClient || clientList.isEmpty()) {
         QWeakPointer<TabBoxClient> desktopClient = tabBox->desktopClient();
         if (!desktopClient.isNull())
-            m_clientList.append(desktopClient);
+            clientList.append(desktopClient);
+    }
+    updateClientList(clientList);
+}
+
+void ClientModel::updateClientList(const TabBoxClientList &clientList)
+{
+    // remove the clients which are no longer in the list
+    for (int i = m_clientList.count() - 1; i >= 0; --i) {
+        if (!clientList.contains(m_clientList.at(i))) {
+            beginRemoveRows(QModelIndex(), i, i);
+            m_clientList.removeAt(i);
+            endRemoveRows();
+        }
+    }
+    // move the remaining clients to their new position and insert the new ones
+    for (int i = 0; i < clientList.count(); ++i) {
+        const QWeakPointer<TabBoxClient> &client = clientList.at(i);
+        if (i < m_clientList.count() && m_clientList.at(i) == client) {
+            continue;
+        }
+        const int oldRow = m_clientList.indexOf(client, i);
+        if (oldRow == -1) {
+            beginInsertRows(QModelIndex(), i, i);
+            m_clientList.insert(i, client);
+            endInsertRows();
+        } else {
+            beginMoveRows(QModelIndex(), oldRow, oldRow, QModelIndex(), i);
+            m_clientList.move(oldRow, i);
+            endMoveRows();
+        }
+    }
+    if (m_clientList.count() > clientList.count()) {
+        // only possible if the old list contained duplicates
+        beginRemoveRows(QModelIndex(), clientList.count(), m_clientList.count() - 1);
+        m_clientList.erase(m_clientList.begin() + clientList.count(), m_clientList.end());
+        endRemoveRows();
+    }
+    if (!m_clientList.isEmpty()) {
+        // caption, minimized state etc. might have changed since the last update
+        emit dataChanged(index(0, 0), index(m_clientList.count() - 1, 0));
     }
-    reset();
 }
 
 void ClientModel::close(int i)
@@ -75,7 +75,9 @@ public:
 
     /**
     * Generates a new list of TabBoxClients based on the current config.
-    * Calling this method will reset the model. If partialReset is true
+    * The model is updated incrementally: rows of TabBoxClients which are no
+    * longer in the list are removed, new ones are inserted and the remaining ones
+    * are moved to their new position. If partialReset is true
     * the top of the list is kept as a starting point. If not the the
     * current active client is used as the starting point to generate the
     * list.
@@ -104,6 +106,10 @@ public Q_SLOTS:
     void activate(int index);
 
 private:
+    /**
+    * Transforms the current list into @p clientList emitting the row changes.
+    */
+    void updateClientList(const TabBoxClientList &clientList);
     TabBoxClientList m_clientList;
 };
 
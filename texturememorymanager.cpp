@@ -0,0 +1,177 @@
+/********************************************************************
+ KWin - the KDE window manager
+ This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#include "texturememorymanager.h"
+#include "options.h"
+#include "toplevel.h"
+
+#include <QDBusConnection>
+#include <QVector>
+
+#include <algorithm>
+
+namespace KWin
+{
+
+KWIN_SINGLETON_FACTORY(TextureMemoryManager)
+
+TextureMemoryManager::TextureMemoryManager(QObject *parent)
+    : QObject(parent)
+{
+    QDBusConnection::sessionBus().registerObject(QStringLiteral("/TextureMemory"), this,
+                                                 QDBusConnection::ExportScriptableContents);
+    connect(options, &Options::textureMemoryBudgetChanged, this, &TextureMemoryManager::scheduleEnforceBudget);
+}
+
+TextureMemoryManager::~TextureMemoryManager()
+{
+    QDBusConnection::sessionBus().unregisterObject(QStringLiteral("/TextureMemory"));
+    s_self = nullptr;
+}
+
+qulonglong TextureMemoryManager::budget() const
+{
+    return qulonglong(options->textureMemoryBudget()) * 1024 * 1024;
+}
+
+QVariantMap TextureMemoryManager::usage() const
+{
+    return QVariantMap{
+        {QStringLiteral("windowPixmaps"), total(Owner::WindowPixmap)},
+        {QStringLiteral("decorations"), total(Owner::Decoration)},
+        {QStringLiteral("shadows"), total(Owner::Shadow)},
+        {QStringLiteral("lanczosCache"), total(Owner::LanczosCache)},
+        {QStringLiteral("total"), total()},
+        {QStringLiteral("budget"), budget()}
+    };
+}
+
+void TextureMemoryManager::add(TextureMemoryEntry *entry)
+{
+    m_entries.insert(entry);
+}
+
+void TextureMemoryManager::remove(TextureMemoryEntry *entry)
+{
+    // entries created before the manager are not accounted
+    if (!m_entries.remove(entry)) {
+        return;
+    }
+    resize(entry, 0);
+}
+
+void TextureMemoryManager::resize(TextureMemoryEntry *entry, qint64 bytes)
+{
+    const qint64 delta = bytes - entry->m_bytes;
+    if (delta == 0) {
+        return;
+    }
+    entry->m_bytes = bytes;
+    m_total += delta;
+    m_ownerTotals[int(entry->m_owner)] += delta;
+    if (entry->m_window) {
+        entry->m_window->m_textureMemory += delta;
+    }
+    if (delta > 0) {
+        scheduleEnforceBudget();
+    }
+}
+
+void TextureMemoryManager::scheduleEnforceBudget()
+{
+    const qulonglong limit = budget();
+    if (limit == 0 || m_total <= limit || m_enforceScheduled) {
+        return;
+    }
+    // textures grow while a frame gets painted, evicting has to wait till it is done
+    m_enforceScheduled = true;
+    QMetaObject::invokeMethod(this, "enforceBudget", Qt::QueuedConnection);
+}
+
+void TextureMemoryManager::enforceBudget()
+{
+    m_enforceScheduled = false;
+    const qulonglong limit = budget();
+    if (limit == 0 || m_total <= limit) {
+        return;
+    }
+    QVector<TextureMemoryEntry*> candidates;
+    for (TextureMemoryEntry *entry : qAsConst(m_entries)) {
+        if (entry->m_evict && entry->m_bytes > 0) {
+            candidates << entry;
+        }
+    }
+    std::sort(candidates.begin(), candidates.end(),
+        [] (const TextureMemoryEntry *a, const TextureMemoryEntry *b) {
+            return a->m_lastUse < b->m_lastUse;
+        }
+    );
+    for (TextureMemoryEntry *entry : qAsConst(candidates)) {
+        if (m_total <= limit) {
+            break;
+        }
+        if (!m_entries.contains(entry)) {
+            // destroyed by a previous callback
+            continue;
+        }
+        // the callback might destroy the entry
+        const auto evict = entry->m_evict;
+        evict();
+    }
+}
+
+TextureMemoryEntry::TextureMemoryEntry(TextureMemoryManager::Owner owner, Toplevel *window)
+    : m_owner(owner)
+    , m_window(window)
+{
+    if (auto manager = TextureMemoryManager::self()) {
+        manager->add(this);
+    }
+}
+
+TextureMemoryEntry::~TextureMemoryEntry()
+{
+    if (auto manager = TextureMemoryManager::self()) {
+        manager->remove(this);
+    }
+}
+
+void TextureMemoryEntry::setSize(const QSize &size, int bytesPerPixel)
+{
+    auto manager = TextureMemoryManager::self();
+    if (!manager || !manager->m_entries.contains(this)) {
+        return;
+    }
+    markUsed();
+    manager->resize(this, size.isValid() ? qint64(size.width()) * size.height() * bytesPerPixel : 0);
+}
+
+void TextureMemoryEntry::markUsed()
+{
+    if (auto manager = TextureMemoryManager::self()) {
+        m_lastUse = manager->nextUse();
+    }
+}
+
+void TextureMemoryEntry::setEvictCallback(const std::function<void()> &evict)
+{
+    m_evict = evict;
+}
+
+}
@@ -0,0 +1,143 @@
+/********************************************************************
+ KWin - the KDE window manager
+ This file is part of the KDE project.
+
+Copyright (C) 2018 agent <agent@local>
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*********************************************************************/
+#ifndef KWIN_TEXTURE_MEMORY_MANAGER_H
+#define KWIN_TEXTURE_MEMORY_MANAGER_H
+
+#include <kwinglobals.h>
+
+#include <QObject>
+#include <QPointer>
+#include <QSet>
+#include <QSize>
+#include <QVariantMap>
+
+#include <functional>
+
+namespace KWin
+{
+
+class TextureMemoryEntry;
+class Toplevel;
+
+/**
+ * @brief Accounts the memory of the textures used by the OpenGL compositor.
+ *
+ * Each texture is represented by a TextureMemoryEntry, which knows the owner type and the
+ * window the texture belongs to. The per window total is available through
+ * Toplevel::textureMemory, the overall totals through the D-Bus interface.
+ *
+ * If the total exceeds the budget configured in Options::textureMemoryBudget, textures which
+ * can be regenerated get evicted, the least recently used first.
+ **/
+class KWIN_EXPORT TextureMemoryManager : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.kwin.TextureMemory")
+    /**
+     * The memory used by all accounted textures in bytes.
+     **/
+    Q_PROPERTY(qulonglong total READ total)
+    /**
+     * The budget in bytes, @c 0 if there is none.
+     **/
+    Q_PROPERTY(qulonglong budget READ budget)
+public:
+    enum class Owner {
+        WindowPixmap,
+        Decoration,
+        Shadow,
+        LanczosCache,
+        Count
+    };
+    virtual ~TextureMemoryManager();
+
+    qulonglong total() const {
+        return m_total;
+    }
+    qulonglong total(Owner owner) const {
+        return m_ownerTotals[int(owner)];
+    }
+    qulonglong budget() const;
+
+public Q_SLOTS:
+    /**
+     * @returns The memory in bytes per owner type
+     **/
+    Q_SCRIPTABLE QVariantMap usage() const;
+
+private Q_SLOTS:
+    /**
+     * Evicts textures till the total is within the budget again.
+     **/
+    void enforceBudget();
+
+private:
+    friend class TextureMemoryEntry;
+    void add(TextureMemoryEntry *entry);
+    void remove(TextureMemoryEntry *entry);
+    void resize(TextureMemoryEntry *entry, qint64 bytes);
+    quint64 nextUse() {
+        return ++m_useCounter;
+    }
+    void scheduleEnforceBudget();
+    QSet<TextureMemoryEntry*> m_entries;
+    qulonglong m_ownerTotals[int(Owner::Count)] = {};
+    qulonglong m_total = 0;
+    quint64 m_useCounter = 0;
+    bool m_enforceScheduled = false;
+    KWIN_SINGLETON(TextureMemoryManager)
+};
+
+/**
+ * @brief The accounting of one texture, to be held by the owner of the texture.
+ **/
+class KWIN_EXPORT TextureMemoryEntry
+{
+public:
+    explicit TextureMemoryEntry(TextureMemoryManager::Owner owner, Toplevel *window = nullptr);
+    ~TextureMemoryEntry();
+
+    /**
+     * Accounts a texture of @p size with @p bytesPerPixel, an empty size for no texture.
+     **/
+    void setSize(const QSize &size, int bytesPerPixel = 4);
+    /**
+     * Marks the texture as used, evictable textures get evicted the least recently used first.
+     **/
+    void markUsed();
+    /**
+     * Makes the texture evictable. The @p evict callback frees the texture if that is possible
+     * at the moment.
+     **/
+    void setEvictCallback(const std::function<void()> &evict);
+
+private:
+    friend class TextureMemoryManager;
+    TextureMemoryManager::Owner m_owner;
+    QPointer<Toplevel> m_window;
+    qint64 m_bytes = 0;
+    quint64 m_lastUse = 0;
+    std::function<void()> m_evict;
+    Q_DISABLE_COPY(TextureMemoryEntry)
+};
+
+}
+
+#endif
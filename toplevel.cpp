@@ -26,6 +26,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "atoms.h"
 #include "client.h"
 #include "client_machine.h"
+#include "composite.h"
 #include "effects.h"
 #include "screens.h"
 #include "shadow.h"
@@ -63,6 +64,9 @@ Toplevel::Toplevel()
 Toplevel::~Toplevel()
 {
     assert(damage_handle == None);
+    if (Compositor *c = Compositor::self()) {
+        c->removeDirtyWindow(this);
+    }
     delete info;
 }
 
@@ -96,9 +100,23 @@ QRect Toplevel::decorationRect() const
 }
 
 void Toplevel::detectShape(Window id)
+{
+    auto extents = fetchShape(id);
+    readShape(extents);
+}
+
+Xcb::ShapeExtents Toplevel::fetchShape(xcb_window_t id) const
+{
+    if (!Xcb::Extensions::self()->isShapeAvailable()) {
+        return Xcb::ShapeExtents();
+    }
+    return Xcb::ShapeExtents(id);
+}
+
+void Toplevel::readShape(Xcb::ShapeExtents &extents)
 {
     const bool wasShape = is_shape;
-    is_shape = Xcb::Extensions::self()->hasShape(id);
+    is_shape = !extents.isNull() && extents->bounding_shaped > 0;
     if (wasShape != is_shape) {
         emit shapedChanged();
     }
@@ -116,6 +134,7 @@ void Toplevel::copyToDeleted(Toplevel* c)
     damage_handle = None;
     damage_region = c->damage_region;
     repaints_region = c->repaints_region;
+    markAsDirty();
     is_shape = c->is_shape;
     effect_window = c->effect_window;
     if (effect_window != NULL)
@@ -380,6 +399,21 @@ void Toplevel::getWmOpaqueRegion()
     opaque_region = new_opaque_region;
 }
 
+QByteArray Toplevel::readProperty(xcb_atom_t atom, xcb_atom_t type, int format)
+{
+    return m_propertyCache.read(atom, type, format);
+}
+
+void Toplevel::prefetchProperty(xcb_atom_t atom)
+{
+    m_propertyCache.fetch(atom);
+}
+
+void Toplevel::invalidateProperty(xcb_atom_t atom)
+{
+    m_propertyCache.invalidate(atom);
+}
+
 bool Toplevel::isClient() const
 {
     return false;
@@ -484,6 +518,7 @@ void Toplevel::setSurface(KWayland::Server::SurfaceInterface *surface)
 void Toplevel::addDamage(const QRegion &damage)
 {
     m_isDamaged = true;
+    markAsDirty();
     damage_region += damage;
     for (const QRect &r : damage.rects()) {
         emit damaged(this, r);
@@ -210,6 +210,12 @@ class KWIN_EXPORT Toplevel
      */
     Q_PROPERTY(KWayland::Server::SurfaceInterface *surface READ surface)
 
+    /**
+     * The memory in bytes of the textures the compositor holds for this Toplevel.
+     * Only accounted by the OpenGL compositor.
+     **/
+    Q_PROPERTY(qulonglong textureMemory READ textureMemory)
+
 public:
     explicit Toplevel();
     virtual xcb_window_t frameId() const;
@@ -356,6 +362,21 @@ public:
      **/
     virtual bool wantsShadowToBeRendered() const;
 
+    /**
+     * Reads the X11 property @p atom of this window. The property is kept in a per-window
+     * cache shared by all readers until a PropertyNotify for @p atom invalidates it.
+     * @returns The property data or a null QByteArray if it does not exist or @p type
+     * and @p format do not match.
+     * @see prefetchProperty
+     **/
+    QByteArray readProperty(xcb_atom_t atom, xcb_atom_t type, int format);
+    /**
+     * Requests the X11 property @p atom into the property cache without waiting for
+     * the reply. Use this to batch the requests before reading the properties of many windows.
+     **/
+    void prefetchProperty(xcb_atom_t atom);
+    void invalidateProperty(xcb_atom_t atom);
+
     /**
      * This method returns the area that the Toplevel window reports to be opaque.
      * It is supposed to only provide valuable information if @link hasAlpha is @c true .
@@ -386,6 +407,9 @@ public:
 
     quint32 surfaceId() const;
     KWayland::Server::SurfaceInterface *surface() const;
+    qulonglong textureMemory() const {
+        return m_textureMemory;
+    }
     void setSurface(KWayland::Server::SurfaceInterface *surface);
 
     virtual void setInternalFramebufferObject(const QSharedPointer<QOpenGLFramebufferObject> &fbo);
@@ -504,6 +528,8 @@ protected:
     virtual ~Toplevel();
     void setWindowHandles(xcb_window_t client);
     void detectShape(Window id);
+    Xcb::ShapeExtents fetchShape(xcb_window_t id) const;
+    void readShape(Xcb::ShapeExtents &extents);
     virtual void propertyNotifyEvent(xcb_property_notify_event_t *e);
     virtual void damageNotifyEvent();
     virtual void clientMessageEvent(xcb_client_message_event_t *e);
@@ -545,11 +571,20 @@ protected:
     QRegion layer_repaints_region;
 
 protected:
+    /**
+     * Registers this Toplevel with the Compositor after it got damaged or repaints were added.
+     **/
+    void markAsDirty();
+    xcb_damage_damage_t damageHandle() const {
+        return damage_handle;
+    }
     bool m_isDamaged;
 
 private:
+    friend class TextureMemoryManager;
     // when adding new data members, check also copyToDeleted()
     Xcb::Window m_client;
+    Xcb::PropertyCache m_propertyCache; // not copied to Deleted, the X11 window is gone
     xcb_damage_damage_t damage_handle;
     QRegion damage_region; // damage is really damaged window (XDamage) and texture needs
     bool is_shape;
@@ -569,6 +604,8 @@ private:
      * An FBO object KWin internal windows might render to.
      **/
     QSharedPointer<QOpenGLFramebufferObject> m_internalFBO;
+    // not copied to Deleted, the textures are accounted where they are held
+    qulonglong m_textureMemory = 0;
     // when adding new data members, check also copyToDeleted()
 };
 
@@ -581,6 +618,7 @@ inline void Toplevel::setWindowHandles(xcb_window_t w)
 {
     assert(!m_client.isValid() && w != XCB_WINDOW_NONE);
     m_client.reset(w, false);
+    m_propertyCache.setWindow(w);
 }
 
 inline QRect Toplevel::geometry() const
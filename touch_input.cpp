@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "abstract_client.h"
 #include "input.h"
 #include "input_event_spy.h"
+#include "pointer_input.h"
 #include "toplevel.h"
 #include "wayland_server.h"
 #include "workspace.h"
@@ -153,9 +154,10 @@ void TouchInputRedirection::processDown(qint32 id, const QPointF &pos, quint32 t
     if (!m_inited) {
         return;
     }
+    input()->pointer()->flushPendingMotion();
     m_windowUpdatedInCycle = false;
     m_input->processSpies(std::bind(&InputEventSpy::touchDown, std::placeholders::_1, id, pos, time));
-    m_input->processFilters(std::bind(&InputEventFilter::touchDown, std::placeholders::_1, id, pos, time));
+    m_input->processFilters(InputEventFilter::EventType::Touch, std::bind(&InputEventFilter::touchDown, std::placeholders::_1, id, pos, time));
     m_windowUpdatedInCycle = false;
 }
 
@@ -165,9 +167,10 @@ void TouchInputRedirection::processUp(qint32 id, quint32 time, LibInput::Device
     if (!m_inited) {
         return;
     }
+    input()->pointer()->flushPendingMotion();
     m_windowUpdatedInCycle = false;
     m_input->processSpies(std::bind(&InputEventSpy::touchUp, std::placeholders::_1, id, time));
-    m_input->processFilters(std::bind(&InputEventFilter::touchUp, std::placeholders::_1, id, time));
+    m_input->processFilters(InputEventFilter::EventType::Touch, std::bind(&InputEventFilter::touchUp, std::placeholders::_1, id, time));
     m_windowUpdatedInCycle = false;
 }
 
@@ -177,9 +180,10 @@ void TouchInputRedirection::processMotion(qint32 id, const QPointF &pos, quint32
     if (!m_inited) {
         return;
     }
+    input()->pointer()->flushPendingMotion();
     m_windowUpdatedInCycle = false;
     m_input->processSpies(std::bind(&InputEventSpy::touchMotion, std::placeholders::_1, id, pos, time));
-    m_input->processFilters(std::bind(&InputEventFilter::touchMotion, std::placeholders::_1, id, pos, time));
+    m_input->processFilters(InputEventFilter::EventType::Touch, std::bind(&InputEventFilter::touchMotion, std::placeholders::_1, id, pos, time));
     m_windowUpdatedInCycle = false;
 }
 
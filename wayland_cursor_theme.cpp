@@ -21,6 +21,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "cursor.h"
 #include "wayland_server.h"
 // Qt
+#include <QFutureWatcher>
+#include <QtConcurrentRun>
 #include <QVector>
 // KWayland
 #include <KWayland/Client/shm_pool.h>
@@ -41,22 +43,18 @@ WaylandCursorTheme::WaylandCursorTheme(KWayland::Client::ShmPool *shm, QObject *
 
 WaylandCursorTheme::~WaylandCursorTheme()
 {
+    if (m_loading) {
+        m_loading->waitForFinished();
+        if (wl_cursor_theme *theme = m_loading->result()) {
+            wl_cursor_theme_destroy(theme);
+        }
+    }
     destroyTheme();
 }
 
-void WaylandCursorTheme::loadTheme()
+int WaylandCursorTheme::themeSize() const
 {
-    if (!m_shm->isValid()) {
-        return;
-    }
-    Cursor *c = Cursor::self();
-    if (!m_theme) {
-        // so far the theme had not been created, this means we need to start tracking theme changes
-        connect(c, &Cursor::themeChanged, this, &WaylandCursorTheme::loadTheme);
-    } else {
-        destroyTheme();
-    }
-    int size = c->themeSize();
+    int size = Cursor::self()->themeSize();
     if (size == 0) {
         // resolution depended
         // as we don't support per screen cursor sizes yet, we use the first screen
@@ -65,9 +63,65 @@ void WaylandCursorTheme::loadTheme()
         // calculate dots per inch, multiplied with magic constants from Cursor::loadThemeSettings()
         size = qreal(output->pixelSize().height()) / (qreal(output->physicalSize().height()) * 0.0393701) * 16.0 / 72.0;
     }
-    m_theme = wl_cursor_theme_load(c->themeName().toUtf8().constData(),
-                                   size, m_shm->shm());
-    emit themeChanged();
+    return size;
+}
+
+void WaylandCursorTheme::preload()
+{
+    if (m_theme || m_loading) {
+        return;
+    }
+    startLoading();
+}
+
+void WaylandCursorTheme::loadTheme()
+{
+    startLoading();
+    finishLoading();
+}
+
+void WaylandCursorTheme::startLoading()
+{
+    if (!m_shm->isValid()) {
+        return;
+    }
+    if (m_loading) {
+        // the theme changed while the previous one was still being read
+        finishLoading();
+    }
+    Cursor *c = Cursor::self();
+    if (!m_trackingThemeChanges) {
+        m_trackingThemeChanges = true;
+        connect(c, &Cursor::themeChanged, this, &WaylandCursorTheme::startLoading);
+    }
+    const QByteArray name = c->themeName().toUtf8();
+    const int size = themeSize();
+    wl_shm *shm = m_shm->shm();
+    // reading the theme only creates the shm pools, which is safe to do from another thread
+    m_loading = new QFutureWatcher<wl_cursor_theme*>(this);
+    connect(m_loading, &QFutureWatcher<wl_cursor_theme*>::finished, this, &WaylandCursorTheme::finishLoading);
+    m_loading->setFuture(QtConcurrent::run(
+        [name, size, shm] {
+            return wl_cursor_theme_load(name.constData(), size, shm);
+        }
+    ));
+}
+
+void WaylandCursorTheme::finishLoading()
+{
+    if (!m_loading) {
+        return;
+    }
+    m_loading->waitForFinished();
+    wl_cursor_theme *theme = m_loading->result();
+    m_loading->disconnect(this);
+    m_loading->deleteLater();
+    m_loading = nullptr;
+    destroyTheme();
+    m_theme = theme;
+    // get() finishes the loading while a cursor is looked up, the users of the theme
+    // must not reload their cursors in the middle of that
+    QMetaObject::invokeMethod(this, "themeChanged", Qt::QueuedConnection);
 }
 
 void WaylandCursorTheme::destroyTheme()
@@ -86,6 +140,9 @@ wl_cursor_image *WaylandCursorTheme::get(Qt::CursorShape shape)
 
 wl_cursor_image *WaylandCursorTheme::get(const QByteArray &name)
 {
+    if (m_loading) {
+        finishLoading();
+    }
     if (!m_theme) {
         loadTheme();
     }
@@ -27,6 +27,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 struct wl_cursor_image;
 struct wl_cursor_theme;
 
+template <typename T>
+class QFutureWatcher;
+
 namespace KWayland
 {
 namespace Client
@@ -48,14 +51,28 @@ public:
     wl_cursor_image *get(Qt::CursorShape shape);
     wl_cursor_image *get(const QByteArray &name);
 
+    /**
+     * Starts reading the theme files in a thread, so that the first get does not block on it.
+     * themeChanged is emitted once the theme got loaded. Afterwards changes of the cursor theme
+     * are loaded in a thread as well.
+     *
+     * themeChanged is always delivered queued, as a get() might finish the loading.
+     **/
+    void preload();
+
 Q_SIGNALS:
     void themeChanged();
 
 private:
     void loadTheme();
+    void startLoading();
+    void finishLoading();
     void destroyTheme();
+    int themeSize() const;
     wl_cursor_theme *m_theme;
     KWayland::Client::ShmPool *m_shm = nullptr;
+    QFutureWatcher<wl_cursor_theme*> *m_loading = nullptr;
+    bool m_trackingThemeChanges = false;
 };
 
 }
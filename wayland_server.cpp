@@ -55,6 +55,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 
 // Qt
 #include <QThread>
+#include <QTimer>
 #include <QWindow>
 
 // system
@@ -153,6 +154,7 @@ void WaylandServer::createSurface(T *surface)
     } else {
         m_clients << client;
     }
+    addClientToIndex(client);
     if (client->readyForPainting()) {
         emit shellClientAdded(client);
     } else {
@@ -554,44 +556,72 @@ void WaylandServer::removeClient(ShellClient *c)
 {
     m_clients.removeAll(c);
     m_internalClients.removeAll(c);
+    removeClientFromIndex(c);
     emit shellClientRemoved(c);
 }
 
-void WaylandServer::dispatch()
+void WaylandServer::addClientToIndex(ShellClient *c)
 {
-    if (!m_display) {
-        return;
+    SurfaceInterface *surface = c->surface();
+    const ClientIndexEntry entry = {
+        surface,
+        surface ? surface->client() : nullptr,
+        c->windowId()
+    };
+    m_clientIndex.insert(c, entry);
+    if (entry.surface) {
+        m_clientsBySurface.insert(entry.surface, c);
     }
-    if (m_internalConnection.server) {
-        m_internalConnection.server->flush();
+    if (entry.windowId != 0) {
+        m_clientsById.insert(entry.windowId, c);
+    }
+    if (entry.connection) {
+        m_clientsByConnection.insert(entry.connection, c);
     }
-    m_display->dispatchEvents(0);
 }
 
-static ShellClient *findClientInList(const QList<ShellClient*> &clients, quint32 id)
+void WaylandServer::removeClientFromIndex(ShellClient *c)
 {
-    auto it = std::find_if(clients.begin(), clients.end(),
-        [id] (ShellClient *c) {
-            return c->windowId() == id;
-        }
-    );
-    if (it == clients.end()) {
-        return nullptr;
+    auto it = m_clientIndex.find(c);
+    if (it == m_clientIndex.end()) {
+        return;
+    }
+    const ClientIndexEntry &entry = it.value();
+    auto surfaceIt = m_clientsBySurface.find(entry.surface);
+    if (surfaceIt != m_clientsBySurface.end() && surfaceIt.value() == c) {
+        m_clientsBySurface.erase(surfaceIt);
     }
-    return *it;
+    auto idIt = m_clientsById.find(entry.windowId);
+    if (idIt != m_clientsById.end() && idIt.value() == c) {
+        m_clientsById.erase(idIt);
+    }
+    m_clientsByConnection.remove(entry.connection, c);
+    m_clientIndex.erase(it);
 }
 
-static ShellClient *findClientInList(const QList<ShellClient*> &clients, KWayland::Server::SurfaceInterface *surface)
+void WaylandServer::scheduleDispatch()
 {
-    auto it = std::find_if(clients.begin(), clients.end(),
-        [surface] (ShellClient *c) {
-            return c->surface() == surface;
+    if (m_dispatchScheduled) {
+        return;
+    }
+    m_dispatchScheduled = true;
+    QTimer::singleShot(0, this,
+        [this] {
+            m_dispatchScheduled = false;
+            dispatch();
         }
     );
-    if (it == clients.end()) {
-        return nullptr;
+}
+
+void WaylandServer::dispatch()
+{
+    if (!m_display) {
+        return;
     }
-    return *it;
+    if (m_internalConnection.server) {
+        m_internalConnection.server->flush();
+    }
+    m_display->dispatchEvents(0);
 }
 
 ShellClient *WaylandServer::findClient(quint32 id) const
@@ -599,13 +629,7 @@ ShellClient *WaylandServer::findClient(quint32 id) const
     if (id == 0) {
         return nullptr;
     }
-    if (ShellClient *c = findClientInList(m_clients, id)) {
-        return c;
-    }
-    if (ShellClient *c = findClientInList(m_internalClients, id)) {
-        return c;
-    }
-    return nullptr;
+    return m_clientsById.value(id, nullptr);
 }
 
 ShellClient *WaylandServer::findClient(SurfaceInterface *surface) const
@@ -613,13 +637,15 @@ ShellClient *WaylandServer::findClient(SurfaceInterface *surface) const
     if (!surface) {
         return nullptr;
     }
-    if (ShellClient *c = findClientInList(m_clients, surface)) {
-        return c;
-    }
-    if (ShellClient *c = findClientInList(m_internalClients, surface)) {
-        return c;
+    return m_clientsBySurface.value(surface, nullptr);
+}
+
+QList<ShellClient*> WaylandServer::findClients(ClientConnection *connection) const
+{
+    if (!connection) {
+        return QList<ShellClient*>();
     }
-    return nullptr;
+    return m_clientsByConnection.values(connection);
 }
 
 AbstractClient *WaylandServer::findAbstractClient(SurfaceInterface *surface) const
@@ -111,6 +111,10 @@ public:
     ShellClient *findClient(KWayland::Server::SurfaceInterface *surface) const;
     AbstractClient *findAbstractClient(KWayland::Server::SurfaceInterface *surface) const;
     ShellClient *findClient(QWindow *w) const;
+    /**
+     * @returns all ShellClients created for surfaces of the given @p connection
+     **/
+    QList<ShellClient*> findClients(KWayland::Server::ClientConnection *connection) const;
 
     /**
      * @returns file descriptor for Xwayland to connect to.
@@ -163,6 +167,11 @@ public:
         return m_internalConnection.registry;
     }
     void dispatch();
+    /**
+     * Dispatches the Wayland events once control returns to the event loop.
+     * Multiple calls before that are compressed into one dispatch.
+     **/
+    void scheduleDispatch();
     quint32 createWindowId(KWayland::Server::SurfaceInterface *surface);
 
     /**
@@ -200,6 +209,8 @@ private:
     void configurationChangeRequested(KWayland::Server::OutputConfigurationInterface *config);
     template <class T>
     void createSurface(T *surface);
+    void addClientToIndex(ShellClient *c);
+    void removeClientFromIndex(ShellClient *c);
     void initScreenLocker();
     KWayland::Server::Display *m_display = nullptr;
     KWayland::Server::CompositorInterface *m_compositor = nullptr;
@@ -234,8 +245,23 @@ private:
     } m_xclipbaordSync;
     QList<ShellClient*> m_clients;
     QList<ShellClient*> m_internalClients;
+    /**
+     * Indexes over m_clients and m_internalClients, updated when a client is added or removed.
+     * The surface and connection are remembered per client as they might already be gone
+     * when the client gets removed.
+     **/
+    struct ClientIndexEntry {
+        KWayland::Server::SurfaceInterface *surface;
+        KWayland::Server::ClientConnection *connection;
+        quint32 windowId;
+    };
+    QHash<ShellClient*, ClientIndexEntry> m_clientIndex;
+    QHash<KWayland::Server::SurfaceInterface*, ShellClient*> m_clientsBySurface;
+    QHash<quint32, ShellClient*> m_clientsById;
+    QMultiHash<KWayland::Server::ClientConnection*, ShellClient*> m_clientsByConnection;
     QHash<KWayland::Server::ClientConnection*, quint16> m_clientIds;
     InitalizationFlags m_initFlags;
+    bool m_dispatchScheduled = false;
     QVector<KWayland::Server::PlasmaShellSurfaceInterface*> m_plasmaShellSurfaces;
     KWIN_SINGLETON(WaylandServer)
 };
@@ -533,8 +533,7 @@ Workspace::~Workspace()
     delete startup;
     delete Placement::self();
     delete client_keys_dialog;
-    foreach (SessionInfo * s, session)
-    delete s;
+    session.clear();
 
     // TODO: ungrabXServer();
 
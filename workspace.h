@@ -28,6 +28,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "options.h"
 #include "utils.h"
 // Qt
+#include <QPointer>
 #include <QTimer>
 #include <QVector>
 // std
@@ -538,7 +539,12 @@ private:
     void loadSessionInfo(const QString &key);
     void addSessionInfo(KConfigGroup &cg);
 
-    QList<SessionInfo*> session;
+    SessionInfoStore session;
+    /**
+     * Puts the session restored clients at their session stacking positions in one pass.
+     **/
+    void applySessionStackingOrder();
+    QVector<QPointer<Client>> m_pendingSessionStacking;
     static const char* windowTypeToTxt(NET::WindowType type);
     static NET::WindowType txtToWindowType(const char* txt);
     static bool sessionInfoWindowTypeMatch(Client* c, SessionInfo* info);
@@ -498,8 +498,7 @@ bool Extensions::hasShape(xcb_window_t w) const
     if (!isShapeAvailable()) {
         return false;
     }
-    ScopedCPointer<xcb_shape_query_extents_reply_t> extents(xcb_shape_query_extents_reply(
-        connection(), xcb_shape_query_extents_unchecked(connection(), w), NULL));
+    ShapeExtents extents(w);
     if (extents.isNull()) {
         return false;
     }
@@ -616,5 +615,101 @@ bool Shm::init()
     return true;
 }
 
+// initial number of 32 bit units requested for a cached property
+static const uint32_t s_propertyCacheLength = 32768;
+
+PropertyCache::~PropertyCache()
+{
+    clear();
+}
+
+void PropertyCache::setWindow(xcb_window_t window)
+{
+    if (m_window == window) {
+        return;
+    }
+    clear();
+    m_window = window;
+}
+
+void PropertyCache::fetch(xcb_atom_t atom)
+{
+    if (m_window == XCB_WINDOW_NONE || m_entries.contains(atom)) {
+        return;
+    }
+    Entry &entry = m_entries[atom];
+    entry.cookie = xcb_get_property_unchecked(connection(), false, m_window, atom, XCB_ATOM_ANY, 0, s_propertyCacheLength);
+    entry.pending = true;
+}
+
+QByteArray PropertyCache::read(xcb_atom_t atom, xcb_atom_t type, int format)
+{
+    if (m_window == XCB_WINDOW_NONE) {
+        return QByteArray();
+    }
+    fetch(atom);
+    Entry &entry = m_entries[atom];
+    if (entry.pending) {
+        resolve(atom, entry);
+    }
+    if (!entry.exists || entry.type != type || entry.format != format) {
+        return QByteArray();
+    }
+    if (entry.data.isNull()) {
+        return QByteArray("", 0); // valid, not null, but empty data
+    }
+    return entry.data;
+}
+
+void PropertyCache::resolve(xcb_atom_t atom, Entry &entry)
+{
+    entry.pending = false;
+    ScopedCPointer<xcb_get_property_reply_t> reply(xcb_get_property_reply(connection(), entry.cookie, nullptr));
+    uint32_t len = s_propertyCacheLength;
+    while (!reply.isNull() && reply->bytes_after > 0) {
+        // property got larger than expected, retry synchronously with enough space
+        len *= 2;
+        reply.reset(xcb_get_property_reply(connection(),
+            xcb_get_property_unchecked(connection(), false, m_window, atom, XCB_ATOM_ANY, 0, len), nullptr));
+    }
+    if (reply.isNull() || reply->type == XCB_ATOM_NONE) {
+        entry.exists = false;
+        return;
+    }
+    entry.exists = true;
+    entry.type = reply->type;
+    entry.format = reply->format;
+    const int length = xcb_get_property_value_length(reply.data());
+    if (length > 0) {
+        entry.data = QByteArray(reinterpret_cast<const char*>(xcb_get_property_value(reply.data())), length);
+    }
+}
+
+void PropertyCache::discard(Entry &entry)
+{
+    if (entry.pending) {
+        xcb_discard_reply(connection(), entry.cookie.sequence);
+        entry.pending = false;
+    }
+}
+
+void PropertyCache::invalidate(xcb_atom_t atom)
+{
+    auto it = m_entries.find(atom);
+    if (it == m_entries.end()) {
+        return;
+    }
+    discard(*it);
+    m_entries.erase(it);
+}
+
+void PropertyCache::clear()
+{
+    for (auto it = m_entries.begin(); it != m_entries.end(); ++it) {
+        discard(*it);
+    }
+    m_entries.clear();
+}
+
 } // namespace Xcb
 } // namespace KWin
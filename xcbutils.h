@@ -23,6 +23,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <kwinglobals.h>
 #include "main.h"
 
+#include <QHash>
 #include <QRect>
 #include <QRegion>
 #include <QScopedPointer>
@@ -31,6 +32,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <xcb/xcb.h>
 #include <xcb/composite.h>
 #include <xcb/randr.h>
+#include <xcb/shape.h>
 
 #include <xcb/shm.h>
 
@@ -589,6 +591,7 @@ public:
 };
 
 XCB_WRAPPER(Pointer, xcb_query_pointer, xcb_window_t)
+XCB_WRAPPER(ShapeExtents, xcb_shape_query_extents, xcb_window_t)
 
 struct CurrentInputData : public WrapperData< xcb_get_input_focus_reply_t, xcb_get_input_focus_cookie_t >
 {
@@ -868,6 +871,51 @@ public:
     }
 };
 
+/**
+ * @brief Caches the raw content of the properties of one window, keyed by atom.
+ *
+ * A property can be requested with fetch() without waiting for the reply, the
+ * reply is only retrieved on the first read(). Further reads for the same atom
+ * are served from the cache until invalidate() is called for it, which is
+ * supposed to happen when a PropertyNotify for the atom is received.
+ * This allows several consumers of the same property to share one request.
+ **/
+class PropertyCache
+{
+public:
+    PropertyCache() = default;
+    ~PropertyCache();
+
+    void setWindow(xcb_window_t window);
+    /**
+     * Requests the property @p atom unless it is already cached or requested.
+     **/
+    void fetch(xcb_atom_t atom);
+    /**
+     * Returns the property @p atom as a byte array, fetching it if needed. In case
+     * the property does not exist or @p type or @p format do not match a null
+     * QByteArray is returned.
+     **/
+    QByteArray read(xcb_atom_t atom, xcb_atom_t type, int format);
+    void invalidate(xcb_atom_t atom);
+    void clear();
+
+private:
+    struct Entry {
+        xcb_get_property_cookie_t cookie;
+        bool pending = false;
+        bool exists = false;
+        xcb_atom_t type = XCB_ATOM_NONE;
+        uint8_t format = 0;
+        QByteArray data;
+    };
+    void resolve(xcb_atom_t atom, Entry &entry);
+    void discard(Entry &entry);
+    xcb_window_t m_window = XCB_WINDOW_NONE;
+    QHash<xcb_atom_t, Entry> m_entries;
+    Q_DISABLE_COPY(PropertyCache)
+};
+
 class GeometryHints
 {
 public:
@@ -20,11 +20,20 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "xkb.h"
 #include "xkb_qt_mapping.h"
 #include "utils.h"
+#include <config-kwin.h>
 // frameworks
 #include <KConfigGroup>
 // KWayland
 #include <KWayland/Server/seat_interface.h>
 // Qt
+#include <QCryptographicHash>
+#include <QDateTime>
+#include <QDir>
+#include <QDirIterator>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QStandardPaths>
 #include <QTemporaryFile>
 #include <QKeyEvent>
 // xkbcommon
@@ -32,6 +41,8 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <xkbcommon/xkbcommon-compose.h>
 #include <xkbcommon/xkbcommon-keysyms.h>
 // system
+#include <errno.h>
+#include <fcntl.h>
 #include <sys/mman.h>
 #include <unistd.h>
 
@@ -112,6 +123,9 @@ Xkb::Xkb(QObject *parent)
 
 Xkb::~Xkb()
 {
+    if (m_keymapFile.fd != -1) {
+        close(m_keymapFile.fd);
+    }
     xkb_compose_state_unref(m_compose.state);
     xkb_compose_table_unref(m_compose.table);
     xkb_state_unref(m_state);
@@ -158,12 +172,101 @@ xkb_keymap *Xkb::loadKeymapFromConfig()
         .variant = nullptr,
         .options = options.constData()
     };
-    return xkb_keymap_new_from_names(m_context, &ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    return loadKeymapFromNames(&ruleNames);
 }
 
 xkb_keymap *Xkb::loadDefaultKeymap()
 {
-    return xkb_keymap_new_from_names(m_context, nullptr, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    return loadKeymapFromNames(nullptr);
+}
+
+xkb_keymap *Xkb::loadKeymapFromNames(const xkb_rule_names *ruleNames)
+{
+    // Compiling from RMLVO names resolves the rules and parses all the included
+    // xkb files, which is far more expensive than parsing an already flattened keymap.
+    // Thus the serialized result is kept in the cache directory and reused as long
+    // as the names, xkbcommon and the xkb data files stay the same.
+    const QString cacheDir = QStandardPaths::writableLocation(QStandardPaths::GenericCacheLocation) + QStringLiteral("/kwin/xkb");
+    const QString cachePath = cacheDir + QLatin1Char('/') + QString::fromLatin1(keymapCacheKey(ruleNames));
+
+    QFile cacheFile(cachePath);
+    if (cacheFile.open(QIODevice::ReadOnly)) {
+        const QByteArray cached = cacheFile.readAll();
+        cacheFile.close();
+        if (xkb_keymap *keymap = xkb_keymap_new_from_string(m_context, cached.constData(), XKB_KEYMAP_FORMAT_TEXT_V1, XKB_KEYMAP_COMPILE_NO_FLAGS)) {
+            return keymap;
+        }
+        qCDebug(KWIN_XKB) << "Discarding unusable cached keymap" << cachePath;
+        cacheFile.remove();
+    }
+
+    xkb_keymap *keymap = xkb_keymap_new_from_names(m_context, ruleNames, XKB_KEYMAP_COMPILE_NO_FLAGS);
+    if (!keymap) {
+        return nullptr;
+    }
+    ScopedCPointer<char> keymapString(xkb_keymap_get_as_string(keymap, XKB_KEYMAP_FORMAT_TEXT_V1));
+    if (!keymapString.isNull() && QDir().mkpath(cacheDir)) {
+        QSaveFile saveFile(cachePath);
+        if (saveFile.open(QIODevice::WriteOnly)) {
+            saveFile.write(keymapString.data());
+            if (!saveFile.commit()) {
+                qCDebug(KWIN_XKB) << "Could not write keymap cache" << cachePath;
+            }
+        }
+    }
+    return keymap;
+}
+
+QByteArray Xkb::keymapCacheKey(const xkb_rule_names *ruleNames) const
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QByteArrayLiteral(XKB_VERSION_STRING));
+
+    // xkbcommon falls back to the environment for unset names, so does the key
+    auto addName = [&hash] (const char *name, const char *variable) {
+        hash.addData(QByteArrayLiteral("\n"));
+        if (name && *name) {
+            hash.addData(name);
+        } else {
+            hash.addData(qgetenv(variable));
+        }
+    };
+    addName(ruleNames ? ruleNames->rules : nullptr, "XKB_DEFAULT_RULES");
+    addName(ruleNames ? ruleNames->model : nullptr, "XKB_DEFAULT_MODEL");
+    addName(ruleNames ? ruleNames->layout : nullptr, "XKB_DEFAULT_LAYOUT");
+    addName(ruleNames ? ruleNames->variant : nullptr, "XKB_DEFAULT_VARIANT");
+    addName(ruleNames ? ruleNames->options : nullptr, "XKB_DEFAULT_OPTIONS");
+
+    // any included xkb data file may change the compiled keymap, so the key covers
+    // the name, size and modification time of every file of all the components
+    const unsigned int includePaths = xkb_context_num_include_paths(m_context);
+    for (unsigned int i = 0; i < includePaths; ++i) {
+        const QByteArray includePath = xkb_context_include_path_get(m_context, i);
+        hash.addData(includePath);
+        const QString path = QFile::decodeName(includePath);
+        for (const QString &component : {QStringLiteral("rules"), QStringLiteral("keycodes"), QStringLiteral("types"),
+                                         QStringLiteral("compat"), QStringLiteral("symbols")}) {
+            const QDir componentDir(path + QLatin1Char('/') + component);
+            QStringList stamps;
+            QDirIterator it(componentDir.path(), QDir::Files, QDirIterator::Subdirectories | QDirIterator::FollowSymlinks);
+            while (it.hasNext()) {
+                it.next();
+                const QFileInfo info = it.fileInfo();
+                stamps << componentDir.relativeFilePath(info.filePath())
+                        + QLatin1Char(' ') + QString::number(info.size())
+                        + QLatin1Char(' ') + QString::number(info.lastModified().toMSecsSinceEpoch());
+            }
+            // the iteration order depends on the file system
+            stamps.sort();
+            hash.addData(QByteArrayLiteral("\n"));
+            hash.addData(component.toUtf8());
+            for (const QString &stamp : qAsConst(stamps)) {
+                hash.addData(QByteArrayLiteral("\n"));
+                hash.addData(QFile::encodeName(stamp));
+            }
+        }
+    }
+    return hash.result().toHex();
 }
 
 void Xkb::installKeymap(int fd, uint32_t size)
@@ -234,27 +337,65 @@ void Xkb::createKeymapFile()
     if (keymapString.isNull()) {
         return;
     }
-    const uint size = qstrlen(keymapString.data()) + 1;
+    const QByteArray contents(keymapString.data());
+    const uint size = contents.size() + 1;
 
-    QTemporaryFile *tmp = new QTemporaryFile(this);
-    if (!tmp->open()) {
-        delete tmp;
+    if (m_keymapFile.fd != -1 && m_keymapFile.contents == contents) {
+        // unchanged keymap, all clients keep sharing the existing file
+        m_seat->setKeymap(m_keymapFile.fd, size);
         return;
     }
-    unlink(tmp->fileName().toUtf8().constData());
-    if (!tmp->resize(size)) {
-        delete tmp;
+
+    const int fd = createKeymapFd(contents);
+    if (fd == -1) {
         return;
     }
-    uchar *address = tmp->map(0, size);
-    if (!address) {
-        return;
+    m_seat->setKeymap(fd, size);
+    if (m_keymapFile.fd != -1) {
+        close(m_keymapFile.fd);
     }
-    if (qstrncpy(reinterpret_cast<char*>(address), keymapString.data(), size) == nullptr) {
-        delete tmp;
-        return;
+    m_keymapFile.fd = fd;
+    m_keymapFile.contents = contents;
+}
+
+int Xkb::createKeymapFd(const QByteArray &keymap)
+{
+    // includes the terminating null byte
+    const uint size = keymap.size() + 1;
+    auto writeAll = [&keymap, size] (int fd) {
+        uint written = 0;
+        while (written < size) {
+            const ssize_t result = write(fd, keymap.constData() + written, size - written);
+            if (result < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            written += result;
+        }
+        return true;
+    };
+#if HAVE_MEMFD
+    int fd = memfd_create("kwin-xkb-keymap", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+    if (fd != -1) {
+        if (writeAll(fd)) {
+            // clients only ever get to read the file, it can be shared safely
+            fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL);
+            return fd;
+        }
+        close(fd);
+    }
+#endif
+    QTemporaryFile tmp;
+    if (!tmp.open()) {
+        return -1;
+    }
+    unlink(QFile::encodeName(tmp.fileName()).constData());
+    if (!writeAll(tmp.handle())) {
+        return -1;
     }
-    m_seat->setKeymap(tmp->handle(), size);
+    return fcntl(tmp.handle(), F_DUPFD_CLOEXEC, 0);
 }
 
 void Xkb::updateModifiers(uint32_t modsDepressed, uint32_t modsLatched, uint32_t modsLocked, uint32_t group)
@@ -33,6 +33,7 @@ struct xkb_keymap;
 struct xkb_state;
 struct xkb_compose_table;
 struct xkb_compose_state;
+struct xkb_rule_names;
 typedef uint32_t xkb_mod_index_t;
 typedef uint32_t xkb_led_index_t;
 typedef uint32_t xkb_keysym_t;
@@ -117,8 +118,11 @@ Q_SIGNALS:
 private:
     xkb_keymap *loadKeymapFromConfig();
     xkb_keymap *loadDefaultKeymap();
+    xkb_keymap *loadKeymapFromNames(const xkb_rule_names *ruleNames);
+    QByteArray keymapCacheKey(const xkb_rule_names *ruleNames) const;
     void updateKeymap(xkb_keymap *keymap);
     void createKeymapFile();
+    int createKeymapFd(const QByteArray &keymap);
     void updateModifiers();
     void updateConsumedModifiers(uint32_t key);
     QString layoutName(xkb_layout_index_t layout) const;
@@ -152,6 +156,15 @@ private:
     } m_modifierState;
 
     QPointer<KWayland::Server::SeatInterface> m_seat;
+
+    /**
+     * The file currently shared with the seat, reused as long as the
+     * serialized keymap does not change.
+     **/
+    struct {
+        int fd = -1;
+        QByteArray contents;
+    } m_keymapFile;
 };
 
 inline